@@ -92,20 +92,16 @@ std::string FileFilterIndex::getIndexableKey(FileData* game, FilterIndexType typ
 	{
 		case GENRE_FILTER:
 		{
-			key = Utils::String::toUpper(game->metadata.get("genre"));
-			key = Utils::String::trim(key);
+			key = game->metadata.get("genre");
+			Utils::String::toUpperInPlace(key);
+			Utils::String::trimInPlace(key);
 			if (getSecondary && !key.empty()) {
-				std::istringstream f(key);
-				std::string newKey;
-				getline(f, newKey, '/');
-				if (!newKey.empty() && newKey != key)
-				{
-					key = newKey;
-				}
+				// the secondary genre is whatever comes before the first '/', if anything
+				const size_t slash = key.find('/');
+				if (slash != std::string::npos && slash != 0)
+					key.erase(slash);
 				else
-				{
-					key = std::string();
-				}
+					key.clear();
 			}
 			break;
 		}
@@ -119,13 +115,14 @@ std::string FileFilterIndex::getIndexableKey(FileData* game, FilterIndexType typ
 		}
 		case PUBDEV_FILTER:
 		{
-			key = Utils::String::toUpper(game->metadata.get("publisher"));
-			key = Utils::String::trim(key);
+			key = game->metadata.get("publisher");
+			Utils::String::trimInPlace(key);
 
 			if ((getSecondary && !key.empty()) || (!getSecondary && key.empty()))
-				key = Utils::String::toUpper(game->metadata.get("developer"));
+				key = game->metadata.get("developer");
 			else
-				key = Utils::String::toUpper(game->metadata.get("publisher"));
+				key = game->metadata.get("publisher");
+			Utils::String::toUpperInPlace(key);
 			break;
 		}
 		case RATINGS_FILTER:
@@ -154,25 +151,28 @@ std::string FileFilterIndex::getIndexableKey(FileData* game, FilterIndexType typ
 		{
 			if (game->getType() != GAME)
 				return "FALSE";
-			key = Utils::String::toUpper(game->metadata.get("favorite"));
+			key = game->metadata.get("favorite");
+			Utils::String::toUpperInPlace(key);
 			break;
 		}
 		case HIDDEN_FILTER:
 		{
 			if (game->getType() != GAME)
 				return "FALSE";
-			key = Utils::String::toUpper(game->metadata.get("hidden"));
+			key = game->metadata.get("hidden");
+			Utils::String::toUpperInPlace(key);
 			break;
 		}
 		case KIDGAME_FILTER:
 		{
 			if (game->getType() != GAME)
 				return "FALSE";
-			key = Utils::String::toUpper(game->metadata.get("kidgame"));
+			key = game->metadata.get("kidgame");
+			Utils::String::toUpperInPlace(key);
 			break;
 		}
 	}
-	key = Utils::String::trim(key);
+	Utils::String::trimInPlace(key);
 	if (key.empty() || (type == RATINGS_FILTER && key == "0 STARS")) {
 		key = UNKNOWN_LABEL;
 	}
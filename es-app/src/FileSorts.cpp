@@ -42,15 +42,11 @@ namespace FileSorts
 	bool compareName(const FileData* file1, const FileData* file2)
 	{
 		// we compare the actual metadata name, as collection files have the system appended which messes up the order
-		std::string name1 = Utils::String::toUpper(file1->metadata.get("sortname"));
-		std::string name2 = Utils::String::toUpper(file2->metadata.get("sortname"));
-		if(name1.empty()){
-			name1 = Utils::String::toUpper(file1->metadata.get("name"));
-		}
-		if(name2.empty()){
-			name2 = Utils::String::toUpper(file2->metadata.get("name"));
-		}
-		return name1.compare(name2) < 0;
+		const std::string& sortName1 = file1->metadata.get("sortname");
+		const std::string& sortName2 = file2->metadata.get("sortname");
+		const std::string& name1 = sortName1.empty() ? file1->metadata.get("name") : sortName1;
+		const std::string& name2 = sortName2.empty() ? file2->metadata.get("name") : sortName2;
+		return Utils::String::compareIgnoreCase(name1, name2) < 0;
 	}
 
 	bool compareRating(const FileData* file1, const FileData* file2)
@@ -90,29 +86,21 @@ namespace FileSorts
 
 	bool compareGenre(const FileData* file1, const FileData* file2)
 	{
-		std::string genre1 = Utils::String::toUpper(file1->metadata.get("genre"));
-		std::string genre2 = Utils::String::toUpper(file2->metadata.get("genre"));
-		return genre1.compare(genre2) < 0;
+		return Utils::String::compareIgnoreCase(file1->metadata.get("genre"), file2->metadata.get("genre")) < 0;
 	}
 
 	bool compareDeveloper(const FileData* file1, const FileData* file2)
 	{
-		std::string developer1 = Utils::String::toUpper(file1->metadata.get("developer"));
-		std::string developer2 = Utils::String::toUpper(file2->metadata.get("developer"));
-		return developer1.compare(developer2) < 0;
+		return Utils::String::compareIgnoreCase(file1->metadata.get("developer"), file2->metadata.get("developer")) < 0;
 	}
 
 	bool comparePublisher(const FileData* file1, const FileData* file2)
 	{
-		std::string publisher1 = Utils::String::toUpper(file1->metadata.get("publisher"));
-		std::string publisher2 = Utils::String::toUpper(file2->metadata.get("publisher"));
-		return publisher1.compare(publisher2) < 0;
+		return Utils::String::compareIgnoreCase(file1->metadata.get("publisher"), file2->metadata.get("publisher")) < 0;
 	}
 
 	bool compareSystem(const FileData* file1, const FileData* file2)
 	{
-		std::string system1 = Utils::String::toUpper(file1->getSystemName());
-		std::string system2 = Utils::String::toUpper(file2->getSystemName());
-		return system1.compare(system2) < 0;
+		return Utils::String::compareIgnoreCase(file1->getSystemName(), file2->getSystemName()) < 0;
 	}
 };
@@ -410,6 +410,7 @@ void SystemScreenSaver::update(int deltaTime)
 	// Use this to update the fade value for the current fade stage
 	if (mState == STATE_FADE_OUT_WINDOW)
 	{
+		Window::invalidate();
 		mOpacity += (float)deltaTime / FADE_TIME;
 		if (mOpacity >= 1.0f)
 		{
@@ -421,6 +422,7 @@ void SystemScreenSaver::update(int deltaTime)
 	}
 	else if (mState == STATE_FADE_IN_VIDEO)
 	{
+		Window::invalidate();
 		mOpacity -= (float)deltaTime / FADE_TIME;
 		if (mOpacity <= 0.0f)
 		{
@@ -437,6 +439,10 @@ void SystemScreenSaver::update(int deltaTime)
 		{
 			nextVideo();
 		}
+		else
+		{
+			Window::scheduleUpdate(mVideoChangeTime - mTimer);
+		}
 	}
 
 	// If we have a loaded video then update it
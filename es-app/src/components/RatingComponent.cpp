@@ -107,7 +107,7 @@ void RatingComponent::render(const Transform4x4f& parentTrans)
 	if (!isVisible())
 		return;
 
-	Transform4x4f trans = parentTrans * getTransform();
+	Transform4x4f trans = getWorldTransform(parentTrans);
 	Renderer::setMatrix(trans);
 
 	mFilledTexture->bind();
@@ -211,6 +211,7 @@ void ScraperSearchComponent::search(const ScraperSearchParams& params)
 
 	mLastSearch = params;
 	mSearchHandle = startScraperSearch(params);
+	requestUpdate();
 }
 
 void ScraperSearchComponent::stop()
@@ -312,6 +313,7 @@ void ScraperSearchComponent::updateInfoPane()
 		if(!thumb.empty())
 		{
 			mThumbnailReq = std::unique_ptr<HttpReq>(new HttpReq(thumb));
+			requestUpdate();
 		}else{
 			mThumbnailReq.reset();
 		}
@@ -352,7 +354,7 @@ bool ScraperSearchComponent::input(InputConfig* config, Input input)
 
 void ScraperSearchComponent::render(const Transform4x4f& parentTrans)
 {
-	Transform4x4f trans = parentTrans * getTransform();
+	Transform4x4f trans = getWorldTransform(parentTrans);
 
 	renderChildren(trans);
 
@@ -373,6 +375,7 @@ void ScraperSearchComponent::returnResult(ScraperSearchResult result)
 	if(!result.imageUrl.empty())
 	{
 		mMDResolveHandle = resolveMetaDataAssets(result, mLastSearch);
+		requestUpdate();
 		return;
 	}
 
@@ -383,6 +386,10 @@ void ScraperSearchComponent::update(int deltaTime)
 {
 	GuiComponent::update(deltaTime);
 
+	// keep polling while anything is in flight, asked for up front because the checks below can end in us being deleted
+	if(mBlockAccept || mThumbnailReq || mSearchHandle || mMDResolveHandle)
+		requestUpdate();
+
 	if(mBlockAccept)
 	{
 		mBusyAnim.update(deltaTime);
@@ -7,6 +7,7 @@
 #include "utils/StringUtil.h"
 #include "Log.h"
 #include "Sound.h"
+#include <algorithm>
 #include <memory>
 
 class TextCache;
@@ -26,10 +27,11 @@ protected:
 	using IList<TextListData, T>::listUpdate;
 	using IList<TextListData, T>::listInput;
 	using IList<TextListData, T>::listRenderTitleOverlay;
-	using IList<TextListData, T>::getTransform;
+	using IList<TextListData, T>::getWorldTransform;
 	using IList<TextListData, T>::mSize;
 	using IList<TextListData, T>::mCursor;
 	using IList<TextListData, T>::Entry;
+	using IList<TextListData, T>::requestUpdate;
 
 public:
 	using IList<TextListData, T>::size;
@@ -44,6 +46,13 @@ public:
 	void applyTheme(const std::shared_ptr<ThemeData>& theme, const std::string& view, const std::string& element, unsigned int properties) override;
 
 	void add(const std::string& name, const T& obj, unsigned int colorId);
+	void add(const T& obj, unsigned int colorId); // named by the name function, see setNameFunction()
+
+	// Brings the list in line with objs without starting over: only the entries between the unchanged head and tail
+	// are touched, entries of objects that are still there keep their text cache and the cursor stays on its object.
+	// New entries are named by the name function.
+	void sync(const std::vector<T>& objs, const std::function<unsigned int(const T&)>& getColorId);
+	void refresh(const T& obj); // builds the entry's text again, e.g. after its name changed
 
 	enum Alignment
 	{
@@ -56,18 +65,21 @@ public:
 
 	inline void setCursorChangedCallback(const std::function<void(CursorState state)>& func) { mCursorChangedCallback = func; }
 
+	// Entries added without a name ask their object for it whenever it's needed, so a list of existing objects doesn't keep a copy of every name
+	inline void setNameFunction(const std::function<const std::string&(const T&)>& func) { mNameFunction = func; }
+
 	inline void setFont(const std::shared_ptr<Font>& font)
 	{
 		mFont = font;
-		for(auto it = mEntries.begin(); it != mEntries.end(); it++)
-			it->data.textCache.reset();
+		evictTextCaches(0, 0);
+		requestUpdate(); // the selected entry might need a marquee now
 	}
 
 	inline void setUppercase(bool /*uppercase*/)
 	{
 		mUppercase = true;
-		for(auto it = mEntries.begin(); it != mEntries.end(); it++)
-			it->data.textCache.reset();
+		evictTextCaches(0, 0);
+		requestUpdate(); // the selected entry might need a marquee now
 	}
 
 	inline void setSelectorHeight(float selectorScale) { mSelectorHeight = selectorScale; }
@@ -82,8 +94,18 @@ public:
 protected:
 	virtual void onScroll(int /*amt*/) { if(!mScrollSound.empty()) Sound::get(mScrollSound)->play(); }
 	virtual void onCursorChanged(const CursorState& state);
+	const std::string& getEntryName(const typename IList<TextListData, T>::Entry& entry) const override;
 
 private:
+	TextCache* getTextCache(int index); // builds it if needed
+	void evictTextCaches(int start, int end); // drops the text caches outside of [start, end)
+
+	// text caches are only built for the entries around the visible ones, they never exist outside of [mCacheStart, mCacheEnd)
+	int mCacheStart;
+	int mCacheEnd;
+
+	std::function<const std::string&(const T&)> mNameFunction;
+
 	int mMarqueeOffset;
 	int mMarqueeOffset2;
 	int mMarqueeTime;
@@ -113,6 +135,9 @@ template <typename T>
 TextListComponent<T>::TextListComponent(Window* window) :
 	IList<TextListData, T>(window), mSelectorImage(window)
 {
+	mCacheStart = 0;
+	mCacheEnd = 0;
+
 	mMarqueeOffset = 0;
 	mMarqueeOffset2 = 0;
 	mMarqueeTime = 0;
@@ -136,7 +161,7 @@ TextListComponent<T>::TextListComponent(Window* window) :
 template <typename T>
 void TextListComponent<T>::render(const Transform4x4f& parentTrans)
 {
-	Transform4x4f trans = parentTrans * getTransform();
+	Transform4x4f trans = getWorldTransform(parentTrans);
 
 	std::shared_ptr<Font>& font = mFont;
 
@@ -165,6 +190,9 @@ void TextListComponent<T>::render(const Transform4x4f& parentTrans)
 	if(listCutoff > size())
 		listCutoff = size();
 
+	// a screen worth of entries above and below keep their text caches, everything further away lets go of them
+	evictTextCaches(startEntry - screenCount, listCutoff + screenCount);
+
 	// draw selector bar
 	if(startEntry < listCutoff)
 	{
@@ -194,10 +222,7 @@ void TextListComponent<T>::render(const Transform4x4f& parentTrans)
 		else
 			color = mColors[entry.data.colorId];
 
-		if(!entry.data.textCache)
-			entry.data.textCache = std::unique_ptr<TextCache>(font->buildTextCache(mUppercase ? Utils::String::toUpper(entry.name) : entry.name, 0, 0, 0x000000FF));
-
-		entry.data.textCache->setColor(color);
+		TextCache* textCache = getTextCache(i);
 
 		Vector3f offset(0, y, 0);
 
@@ -207,12 +232,12 @@ void TextListComponent<T>::render(const Transform4x4f& parentTrans)
 			offset[0] = mHorizontalMargin;
 			break;
 		case ALIGN_CENTER:
-			offset[0] = (int)((mSize.x() - entry.data.textCache->metrics.size.x()) / 2);
+			offset[0] = (int)((mSize.x() - textCache->metrics.size.x()) / 2);
 			if(offset[0] < mHorizontalMargin)
 				offset[0] = mHorizontalMargin;
 			break;
 		case ALIGN_RIGHT:
-			offset[0] = (mSize.x() - entry.data.textCache->metrics.size.x());
+			offset[0] = (mSize.x() - textCache->metrics.size.x());
 			offset[0] -= mHorizontalMargin;
 			if(offset[0] < mHorizontalMargin)
 				offset[0] = mHorizontalMargin;
@@ -229,7 +254,7 @@ void TextListComponent<T>::render(const Transform4x4f& parentTrans)
 			drawTrans.translate(offset);
 
 		Renderer::setMatrix(drawTrans);
-		font->renderTextCache(entry.data.textCache.get());
+		font->renderTextCache(textCache, color);
 
 		// render currently selected item text again if
 		// marquee is scrolled far enough for it to repeat
@@ -238,7 +263,7 @@ void TextListComponent<T>::render(const Transform4x4f& parentTrans)
 			drawTrans = trans;
 			drawTrans.translate(offset - Vector3f((float)mMarqueeOffset2, 0, 0));
 			Renderer::setMatrix(drawTrans);
-			font->renderTextCache(entry.data.textCache.get());
+			font->renderTextCache(textCache, color);
 		}
 
 		y += entrySize;
@@ -304,7 +329,7 @@ void TextListComponent<T>::update(int deltaTime)
 		mMarqueeOffset2 = 0;
 
 		// if we're not scrolling and this object's text goes outside our size, marquee it!
-		const float textLength = mFont->sizeText(mEntries.at((unsigned int)mCursor).name).x();
+		const float textLength = getTextCache(mCursor)->metrics.size.x();
 		const float limit      = mSize.x() - mHorizontalMargin * 2;
 
 		if(textLength > limit)
@@ -327,6 +352,15 @@ void TextListComponent<T>::update(int deltaTime)
 
 			if(mMarqueeOffset > (scrollLength - (limit - returnLength)))
 				mMarqueeOffset2 = (int)(mMarqueeOffset - (scrollLength + returnLength));
+
+			// the marquee loops for as long as the entry stays selected
+			requestUpdate();
+
+			// nothing moves until the delay is over
+			if(mMarqueeTime < delay)
+				Window::scheduleUpdate((int)delay - mMarqueeTime);
+			else
+				Window::invalidate();
 		}
 	}
 
@@ -344,6 +378,166 @@ void TextListComponent<T>::add(const std::string& name, const T& obj, unsigned i
 	entry.object = obj;
 	entry.data.colorId = color;
 	static_cast<IList< TextListData, T >*>(this)->add(entry);
+	requestUpdate();
+}
+
+template <typename T>
+void TextListComponent<T>::add(const T& obj, unsigned int color)
+{
+	assert(color < COLOR_ID_COUNT);
+	assert(mNameFunction);
+
+	typename IList<TextListData, T>::Entry entry;
+	entry.object = obj;
+	entry.data.colorId = color;
+	static_cast<IList< TextListData, T >*>(this)->add(entry);
+	requestUpdate();
+}
+
+template <typename T>
+void TextListComponent<T>::sync(const std::vector<T>& objs, const std::function<unsigned int(const T&)>& getColorId)
+{
+	typedef typename IList<TextListData, T>::Entry Entry;
+
+	const int oldSize = size();
+	const int newSize = (int)objs.size();
+
+	// most changes only add, remove or move a few entries, skip what didn't change at both ends
+	int head = 0;
+	while(head < oldSize && head < newSize && mEntries.at(head).object == objs.at(head))
+		head++;
+
+	if(head == oldSize && head == newSize)
+		return;
+
+	int tail = 0;
+	while(tail < oldSize - head && tail < newSize - head && mEntries.at(oldSize - 1 - tail).object == objs.at(newSize - 1 - tail))
+		tail++;
+
+	const bool hadCursor = oldSize > 0;
+	const T cursorObj = hadCursor ? mEntries.at(mCursor).object : T();
+
+	// sorted by object so the entries that stay can be found again
+	std::vector< std::pair<T, int> > lookup;
+	lookup.reserve(oldSize - tail - head);
+	for(int i = head; i < oldSize - tail; i++)
+		lookup.push_back(std::make_pair(mEntries.at(i).object, i));
+	std::sort(lookup.begin(), lookup.end());
+
+	std::vector<Entry> middle;
+	middle.reserve(newSize - tail - head);
+	for(int i = head; i < newSize - tail; i++)
+	{
+		auto it = std::lower_bound(lookup.begin(), lookup.end(), std::make_pair(objs.at(i), -1));
+		if(it != lookup.end() && it->first == objs.at(i) && it->second >= 0)
+		{
+			middle.push_back(std::move(mEntries.at(it->second)));
+			it->second = -1; // taken
+		}else{
+			Entry entry;
+			entry.object = objs.at(i);
+			entry.data.colorId = getColorId(objs.at(i));
+			middle.push_back(std::move(entry));
+		}
+	}
+
+	mEntries.erase(mEntries.begin() + head, mEntries.begin() + (oldSize - tail));
+	mEntries.insert(mEntries.begin() + head, std::make_move_iterator(middle.begin()), std::make_move_iterator(middle.end()));
+
+	// text caches moved along with their entries, the range has to cover wherever they went
+	if(mCacheStart < mCacheEnd && mCacheEnd > head)
+	{
+		const int delta = newSize - oldSize;
+		if(mCacheStart >= oldSize - tail)
+		{
+			mCacheStart += delta;
+			mCacheEnd += delta;
+		}else{
+			mCacheStart = Math::min(mCacheStart, head);
+			mCacheEnd = Math::max(mCacheEnd + delta, newSize - tail);
+		}
+	}
+
+	// the cursor only moves if its entry did
+	if(hadCursor && mCursor >= head)
+	{
+		auto it = std::find_if(mEntries.cbegin() + head, mEntries.cend(), [&cursorObj](const Entry& entry) { return entry.object == cursorObj; });
+		if(it != mEntries.cend())
+			mCursor = (int)(it - mEntries.cbegin());
+		else
+			mCursor = Math::max(Math::min(mCursor, newSize - 1), 0);
+	}else if(!hadCursor){
+		mCursor = 0;
+	}
+
+	requestUpdate();
+	Window::invalidate();
+}
+
+template <typename T>
+void TextListComponent<T>::refresh(const T& obj)
+{
+	for(auto it = mEntries.begin(); it != mEntries.end(); it++)
+	{
+		if(it->object == obj)
+		{
+			it->data.textCache.reset();
+			requestUpdate(); // the marquee might have to start or stop
+			Window::invalidate();
+			return;
+		}
+	}
+}
+
+template <typename T>
+const std::string& TextListComponent<T>::getEntryName(const typename IList<TextListData, T>::Entry& entry) const
+{
+	if(entry.name.empty() && mNameFunction)
+		return mNameFunction(entry.object);
+
+	return entry.name;
+}
+
+template <typename T>
+TextCache* TextListComponent<T>::getTextCache(int index)
+{
+	typename IList<TextListData, T>::Entry& entry = mEntries.at((unsigned int)index);
+	if(!entry.data.textCache)
+	{
+		const std::string& name = getEntryName(entry);
+		entry.data.textCache = mFont->getTextCache(mUppercase ? Utils::String::toUpper(name) : name);
+
+		if(mCacheStart >= mCacheEnd)
+		{
+			mCacheStart = index;
+			mCacheEnd = index + 1;
+		}else{
+			mCacheStart = Math::min(mCacheStart, index);
+			mCacheEnd = Math::max(mCacheEnd, index + 1);
+		}
+	}
+
+	return entry.data.textCache.get();
+}
+
+template <typename T>
+void TextListComponent<T>::evictTextCaches(int start, int end)
+{
+	// entries might have been removed since the caches were built
+	const int cacheEnd = Math::min(mCacheEnd, size());
+
+	for(int i = mCacheStart; i < Math::min(start, cacheEnd); i++)
+		mEntries.at((unsigned int)i).data.textCache.reset();
+	for(int i = Math::max(end, mCacheStart); i < cacheEnd; i++)
+		mEntries.at((unsigned int)i).data.textCache.reset();
+
+	mCacheStart = Math::max(mCacheStart, start);
+	mCacheEnd = Math::min(mCacheEnd, end);
+	if(mCacheStart >= mCacheEnd)
+	{
+		mCacheStart = 0;
+		mCacheEnd = 0;
+	}
 }
 
 template <typename T>
@@ -353,6 +547,9 @@ void TextListComponent<T>::onCursorChanged(const CursorState& state)
 	mMarqueeOffset2 = 0;
 	mMarqueeTime = 0;
 
+	// update() decides whether the new entry needs a marquee
+	requestUpdate();
+
 	if(mCursorChangedCallback)
 		mCursorChangedCallback(state);
 }
@@ -444,6 +641,8 @@ void TextListComponent<T>::applyTheme(const std::shared_ptr<ThemeData>& theme, c
 	} else {
 		mSelectorImage.setImage("");
 	}
+
+	requestUpdate(); // size and font might have changed the marquee
 }
 
 #endif // ES_APP_COMPONENTS_TEXT_LIST_COMPONENT_H
@@ -3,6 +3,7 @@
 #include "views/gamelist/IGameListView.h"
 #include "FileSorts.h"
 #include "SystemData.h"
+#include "Window.h"
 
 static const std::string LETTERS = "ABCDEFGHIJKLMNOPQRSTUVWXYZ";
 
@@ -106,6 +107,8 @@ void GuiFastSelect::update(int deltaTime)
 			scroll();
 			mScrollAccumulator -= 150;
 		}
+
+		Window::scheduleUpdate(150 - mScrollAccumulator);
 	}
 
 	GuiComponent::update(deltaTime);
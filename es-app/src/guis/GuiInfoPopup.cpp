@@ -3,6 +3,7 @@
 #include "components/ComponentGrid.h"
 #include "components/NinePatchComponent.h"
 #include "components/TextComponent.h"
+#include "Window.h"
 #include <SDL_timer.h>
 
 GuiInfoPopup::GuiInfoPopup(Window* window, std::string message, int duration) :
@@ -71,6 +72,9 @@ void GuiInfoPopup::render(const Transform4x4f& /*parentTrans*/)
 		// if we're still supposed to be rendering it
 		Renderer::setMatrix(trans);
 		renderChildren(trans);
+
+		// it fades and times out on its own, so keep frames coming until it's gone
+		Window::invalidate();
 	}
 }
 
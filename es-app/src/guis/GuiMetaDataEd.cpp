@@ -174,6 +174,9 @@ void GuiMetaDataEd::onSizeChanged()
 	mGrid.setRowHeightPerc(0, (titleHeight + titleSubtitleSpacing + subtitleHeight + TITLE_VERT_PADDING) / mSize.y());
 	mGrid.setRowHeightPerc(2, mButtons->getSize().y() / mSize.y());
 
+	// mHeaderGrid gets its size from mGrid's layout
+	mGrid.layout();
+
 	mHeaderGrid->setRowHeightPerc(1, titleHeight / mHeaderGrid->getSize().y());
 	mHeaderGrid->setRowHeightPerc(2, titleSubtitleSpacing / mHeaderGrid->getSize().y());
 	mHeaderGrid->setRowHeightPerc(3, subtitleHeight / mHeaderGrid->getSize().y());
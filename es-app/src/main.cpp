@@ -3,10 +3,12 @@
 
 #include "guis/GuiDetectDevice.h"
 #include "guis/GuiMsgBox.h"
+#include "resources/Font.h"
 #include "utils/FileSystemUtil.h"
 #include "views/ViewController.h"
 #include "CollectionSystemManager.h"
 #include "EmulationStation.h"
+#include "FramePacer.h"
 #include "InputManager.h"
 #include "Log.h"
 #include "MameNames.h"
@@ -142,6 +144,37 @@ bool parseArgs(int argc, char* argv[])
 		{
 			int maxVRAM = atoi(argv[i + 1]);
 			Settings::getInstance()->setInt("MaxVRAM", maxVRAM);
+		}else if(strcmp(argv[i], "--max-fps") == 0)
+		{
+			if(i >= argc - 1)
+			{
+				std::cerr << "Invalid max fps supplied.";
+				return false;
+			}
+
+			int maxFPS = atoi(argv[i + 1]);
+			Settings::getInstance()->setInt("MaxFPS", maxFPS);
+			i++; // skip the value
+		}else if(strcmp(argv[i], "--capture-frames") == 0)
+		{
+			if(i >= argc - 1)
+			{
+				std::cerr << "Invalid frame capture path supplied.";
+				return false;
+			}
+
+			Settings::getInstance()->setString("FrameCapturePath", argv[i + 1]);
+			i++; // skip the path
+		}else if(strcmp(argv[i], "--frame-stats") == 0)
+		{
+			if(i >= argc - 1)
+			{
+				std::cerr << "Invalid frame stats file supplied.";
+				return false;
+			}
+
+			Settings::getInstance()->setString("FrameStatsFile", argv[i + 1]);
+			i++; // skip the file
 		}
 		else if (strcmp(argv[i], "--force-kiosk") == 0)
 		{
@@ -181,6 +214,9 @@ bool parseArgs(int argc, char* argv[])
 				"--windowed			not fullscreen, should be used with --resolution\n"
 				"--vsync [1/on or 0/off]		turn vsync on or off (default is on)\n"
 				"--max-vram [size]		Max VRAM to use in Mb before swapping. 0 for unlimited\n"
+				"--max-fps [fps]			render at most this many frames per second, 0 for no limit besides vsync\n"
+				"--capture-frames [path]		save every frame to path (headless renderer builds only)\n"
+				"--frame-stats [file]		write renderer stats for every frame to a CSV file\n"
 				"--force-kid		Force the UI mode to be Kid\n"
 				"--force-kiosk		Force the UI mode to be Kiosk\n"
 				"--force-disable-filters		Force the UI to ignore applied filters in gamelist\n"
@@ -367,6 +403,10 @@ int main(int argc, char* argv[])
 	// this makes for no delays when accessing content, but a longer startup time
 	ViewController::get()->preload();
 
+	// rasterize the rest of the commonly used characters for every font the views ended up using while the splash is still up,
+	// this also writes the glyph caches so the next start doesn't have to
+	Font::prewarmGlyphs();
+
 	if(splashScreen && splashScreenProgress)
 		window.renderLoadingScreen("Done.");
 
@@ -388,13 +428,19 @@ int main(int argc, char* argv[])
 	int ps_time = SDL_GetTicks();
 
 	bool running = true;
+	bool rendered = true;
 
 	while(running)
 	{
 		SDL_Event event;
 		bool ps_standby = PowerSaver::getState() && (int) SDL_GetTicks() - ps_time > PowerSaver::getMode();
+		bool renderOnDemand = Settings::getInstance()->getBool("RenderOnDemand");
+
+		// with nothing to render there's no point in spinning, wait for an event or for the next update that's due
+		// right after a frame things are probably still moving, the next update will tell
+		int timeout = ps_standby ? PowerSaver::getTimeout() : (((renderOnDemand && !rendered) || window.isSleeping()) ? window.getIdleTimeout() : 0);
 
-		if(ps_standby ? SDL_WaitEventTimeout(&event, PowerSaver::getTimeout()) : SDL_PollEvent(&event))
+		if(timeout != 0 ? SDL_WaitEventTimeout(&event, timeout) : SDL_PollEvent(&event))
 		{
 			do
 			{
@@ -402,6 +448,8 @@ int main(int argc, char* argv[])
 
 				if(event.type == SDL_QUIT)
 					running = false;
+				else if(event.type == SDL_WINDOWEVENT)
+					Window::invalidate(); // exposed, resized, ...
 			} while(SDL_PollEvent(&event));
 
 			// triggered if exiting from SDL_WaitEvent due to event
@@ -422,8 +470,7 @@ int main(int argc, char* argv[])
 		if(window.isSleeping())
 		{
 			lastTime = SDL_GetTicks();
-			SDL_Delay(1); // this doesn't need to be accurate, we're just giving up our CPU time until something wakes us up
-			continue;
+			continue; // the next wait for events gives up our CPU time until something wakes us up
 		}
 
 		int curTime = SDL_GetTicks();
@@ -434,13 +481,26 @@ int main(int argc, char* argv[])
 		if(deltaTime < 0)
 			deltaTime = 1000;
 
+		FramePacer::beginFrame();
 		window.update(deltaTime);
-		window.render();
-		Renderer::swapBuffers();
+		FramePacer::mark(FramePacer::UPDATE);
+
+		// skip rendering (and waiting for vsync) if the last frame is still up to date
+		rendered = Window::validate() || !renderOnDemand;
+		if(rendered)
+		{
+			window.render();
+			FramePacer::mark(FramePacer::RENDER);
+			Renderer::swapBuffers();
+			FramePacer::mark(FramePacer::SWAP);
+			FramePacer::endFrame();
+		}
 
 		Log::flush();
 	}
 
+	FramePacer::dumpStats();
+
 	while(window.peekGui() != ViewController::get())
 		delete window.peekGui();
 	window.deinit();
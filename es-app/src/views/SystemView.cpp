@@ -569,7 +569,7 @@ void SystemView::renderExtras(const Transform4x4f& trans, float lower, float upp
 			SystemViewData data = mEntries.at(index).data;
 			for (unsigned int j = 0; j < data.backgroundExtras.size(); j++) {
 				GuiComponent *extra = data.backgroundExtras[j];
-				if (extra->getZIndex() >= lower && extra->getZIndex() < upper) {
+				if (extra->getZIndex() >= lower && extra->getZIndex() < upper && !extra->isCulled(extrasTrans)) {
 					extra->render(extrasTrans);
 				}
 			}
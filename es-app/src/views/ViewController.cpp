@@ -32,13 +32,16 @@ void ViewController::init(Window* window)
 }
 
 ViewController::ViewController(Window* window)
-	: GuiComponent(window), mCurrentView(nullptr), mCamera(Transform4x4f::Identity()), mFadeOpacity(0), mLockInput(false)
+	: GuiComponent(window), mCurrentView(nullptr), mCamera(Transform4x4f::Identity()), mFadeOpacity(0), mLockInput(false),
+	mSnapshotTexture(0), mSnapshotPending(false), mSnapshotCamera(Transform4x4f::Identity())
 {
 	mState.viewing = NOTHING;
 }
 
 ViewController::~ViewController()
 {
+	releaseSnapshot();
+
 	assert(sInstance == this);
 	sInstance = NULL;
 }
@@ -153,6 +156,15 @@ void ViewController::playViewTransition()
 		return;
 
 	std::string transition_style = Settings::getInstance()->getString("TransitionStyle");
+
+	// the views we're leaving don't change anymore, capture them once instead of rendering them every frame of the transition
+	releaseSnapshot();
+	if((transition_style == "fade" || transition_style == "slide") && target != -mCamera.translation() && Renderer::canCopyToTexture())
+	{
+		mSnapshotPending = true;
+		mSnapshotCamera = mCamera;
+	}
+
 	if(transition_style == "fade")
 	{
 		// fade
@@ -215,6 +227,9 @@ void ViewController::launch(FileData* game, Vector3f center)
 	if (mCurrentView)
 		mCurrentView->onHide();
 
+	// the launch animation moves the camera in ways a snapshot can't follow
+	releaseSnapshot();
+
 	Transform4x4f origCamera = mCamera;
 	origCamera.translation() = -mCurrentView->getPosition();
 
@@ -262,6 +277,7 @@ void ViewController::removeGameListView(SystemData* system)
 	auto exists = mGameListViews.find(system);
 	if(exists != mGameListViews.cend())
 	{
+		releaseSnapshot();
 		exists->second.reset();
 		mGameListViews.erase(system);
 	}
@@ -386,34 +402,31 @@ void ViewController::update(int deltaTime)
 	}
 
 	updateSelf(deltaTime);
+
+	// the transition is over
+	if(!isAnimationPlaying(0))
+		releaseSnapshot();
 }
 
 void ViewController::render(const Transform4x4f& parentTrans)
 {
 	Transform4x4f trans = mCamera * parentTrans;
-	Transform4x4f transInverse;
-	transInverse.invert(trans);
-
-	// camera position, position + size
-	Vector3f viewStart = transInverse.translation();
-	Vector3f viewEnd = transInverse * Vector3f((float)Renderer::getScreenWidth(), (float)Renderer::getScreenHeight(), 0);
 
 	// Keep track of UI mode changes.
 	UIModeController::getInstance()->monitorUIMode();
 
-	// draw systemview
-	getSystemListView()->render(trans);
+	if(mSnapshotPending)
+		captureSnapshot(parentTrans);
 
-	// draw gamelists
-	for(auto it = mGameListViews.cbegin(); it != mGameListViews.cend(); it++)
-	{
-		// clipping
-		Vector3f guiStart = it->second->getPosition();
-		Vector3f guiEnd = it->second->getPosition() + Vector3f(it->second->getSize().x(), it->second->getSize().y(), 0);
+	if(mSnapshotTexture)
+		renderSnapshot(trans);
 
-		if(guiEnd.x() >= viewStart.x() && guiEnd.y() >= viewStart.y() &&
-			guiStart.x() <= viewEnd.x() && guiStart.y() <= viewEnd.y())
-			it->second->render(trans);
+	// draw the views the camera can see, the ones in the snapshot are already drawn
+	const std::vector<GuiComponent*> views = getVisibleViews(trans);
+	for(auto it = views.cbegin(); it != views.cend(); it++)
+	{
+		if(*it == mCurrentView.get() || std::find(mSnapshotViews.cbegin(), mSnapshotViews.cend(), *it) == mSnapshotViews.cend())
+			(*it)->render(trans);
 	}
 
 	if(mWindow->peekGui() == this)
@@ -428,6 +441,82 @@ void ViewController::render(const Transform4x4f& parentTrans)
 	}
 }
 
+std::vector<GuiComponent*> ViewController::getVisibleViews(const Transform4x4f& trans)
+{
+	std::vector<GuiComponent*> views;
+
+	// systemview first, the gamelists go on top
+	if(!getSystemListView()->isCulled(trans))
+		views.push_back(getSystemListView().get());
+
+	for(auto it = mGameListViews.cbegin(); it != mGameListViews.cend(); it++)
+	{
+		if(!it->second->isCulled(trans))
+			views.push_back(it->second.get());
+	}
+
+	return views;
+}
+
+void ViewController::captureSnapshot(const Transform4x4f& parentTrans)
+{
+	mSnapshotPending = false;
+
+	// render the views like they were when the transition started, the camera may have moved since
+	const Transform4x4f trans = mSnapshotCamera * parentTrans;
+	mSnapshotViews = getVisibleViews(trans);
+	for(auto it = mSnapshotViews.cbegin(); it != mSnapshotViews.cend(); it++)
+		(*it)->render(trans);
+
+	const int width = Renderer::getScreenWidth();
+	const int height = Renderer::getScreenHeight();
+	mSnapshotTexture = Renderer::createTexture(Renderer::Texture::RGBA, false, false, width, height, nullptr);
+	Renderer::copyToTexture(mSnapshotTexture, 0, 0, width, height);
+
+	// paint over them in the clear color, the actual frame starts from there
+	Renderer::setMatrix(parentTrans);
+	Renderer::drawRect(0.0f, 0.0f, (float)width, (float)height, 0xFFFFFFFF, 0xFFFFFFFF, false, Renderer::Blend::ONE, Renderer::Blend::ZERO);
+}
+
+void ViewController::renderSnapshot(const Transform4x4f& trans)
+{
+	// the snapshot sits where the camera was looking when it was taken, transitions only move the camera
+	Transform4x4f snapshotTrans = trans;
+	snapshotTrans.translate(-mSnapshotCamera.translation());
+
+	const float width = (float)Renderer::getScreenWidth();
+	const float height = (float)Renderer::getScreenHeight();
+	const Vector3f& pos = snapshotTrans.translation();
+
+	if(pos.x() <= -width || pos.x() >= width || pos.y() <= -height || pos.y() >= height)
+		return;
+
+	// the copy's rows go bottom to top, it replaces what's below it, alpha included
+	const unsigned int color = Renderer::convertColor(0xFFFFFFFF);
+	Renderer::Vertex vertices[4];
+
+	vertices[0] = { { 0.0f,  0.0f   }, { 0.0f, 1.0f }, color };
+	vertices[1] = { { 0.0f,  height }, { 0.0f, 0.0f }, color };
+	vertices[2] = { { width, 0.0f   }, { 1.0f, 1.0f }, color };
+	vertices[3] = { { width, height }, { 1.0f, 0.0f }, color };
+
+	Renderer::setMatrix(snapshotTrans);
+	Renderer::bindTexture(mSnapshotTexture);
+	Renderer::drawTriangleStrips(vertices, 4, Renderer::Blend::ONE, Renderer::Blend::ZERO);
+}
+
+void ViewController::releaseSnapshot()
+{
+	mSnapshotPending = false;
+	mSnapshotViews.clear();
+
+	if(mSnapshotTexture)
+	{
+		Renderer::destroyTexture(mSnapshotTexture);
+		mSnapshotTexture = 0;
+	}
+}
+
 void ViewController::preload()
 {
 	uint32_t i = 0;
@@ -450,6 +539,8 @@ void ViewController::preload()
 
 void ViewController::reloadGameListView(IGameListView* view, bool reloadTheme)
 {
+	releaseSnapshot();
+
 	for(auto it = mGameListViews.cbegin(); it != mGameListViews.cend(); it++)
 	{
 		if(it->second.get() == view)
@@ -482,6 +573,8 @@ void ViewController::reloadGameListView(IGameListView* view, bool reloadTheme)
 
 void ViewController::reloadAll()
 {
+	releaseSnapshot();
+
 	// clear all gamelistviews
 	std::map<SystemData*, FileData*> cursorMap;
 	for(auto it = mGameListViews.cbegin(); it != mGameListViews.cend(); it++)
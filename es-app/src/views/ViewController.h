@@ -92,6 +92,11 @@ private:
 	void playViewTransition();
 	int getSystemId(SystemData* system);
 
+	std::vector<GuiComponent*> getVisibleViews(const Transform4x4f& trans);
+	void captureSnapshot(const Transform4x4f& parentTrans);
+	void renderSnapshot(const Transform4x4f& trans);
+	void releaseSnapshot();
+
 	std::shared_ptr<GuiComponent> mCurrentView;
 	std::map< SystemData*, std::shared_ptr<IGameListView> > mGameListViews;
 	std::shared_ptr<SystemView> mSystemListView;
@@ -100,6 +105,12 @@ private:
 	float mFadeOpacity;
 	bool mLockInput;
 
+	// the views that were on screen when a transition started, drawn from one texture until it's over
+	unsigned int mSnapshotTexture;
+	bool mSnapshotPending; // captured by the next render()
+	Transform4x4f mSnapshotCamera;
+	std::vector<GuiComponent*> mSnapshotViews;
+
 	State mState;
 };
 
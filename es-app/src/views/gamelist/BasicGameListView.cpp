@@ -13,6 +13,7 @@ BasicGameListView::BasicGameListView(Window* window, FileData* root)
 	mList.setSize(mSize.x(), mSize.y() * 0.8f);
 	mList.setPosition(0, mSize.y() * 0.2f);
 	mList.setDefaultZIndex(20);
+	mList.setNameFunction([](FileData* const& file) -> const std::string& { return file->getName(); }); // no copies of the names
 	addChild(&mList);
 
 	populateList(root->getChildrenListToDisplay());
@@ -29,7 +30,7 @@ void BasicGameListView::onThemeChanged(const std::shared_ptr<ThemeData>& theme)
 
 void BasicGameListView::onFileChanged(FileData* file, FileChangeType change)
 {
-	if(change == FILE_METADATA_CHANGED)
+	if(change == FILE_METADATA_CHANGED && isViewStyleOutdated(file))
 	{
 		// might switch to a detailed view
 		ViewController::get()->reloadGameListView(this);
@@ -47,7 +48,7 @@ void BasicGameListView::populateList(const std::vector<FileData*>& files)
 	{
 		for(auto it = files.cbegin(); it != files.cend(); it++)
 		{
-			mList.add((*it)->getName(), *it, ((*it)->getType() == FOLDER));
+			mList.add(*it, ((*it)->getType() == FOLDER));
 		}
 	}
 	else
@@ -56,6 +57,39 @@ void BasicGameListView::populateList(const std::vector<FileData*>& files)
 	}
 }
 
+void BasicGameListView::updateList(const std::vector<FileData*>& files, FileData* file, FileChangeType change)
+{
+	// the placeholder comes and goes with the whole list
+	if(files.empty() || mList.size() == 0 || mList.getSelected()->isPlaceHolder())
+	{
+		populateList(files);
+		return;
+	}
+
+	mList.sync(files, [](FileData* const& f) { return (unsigned int)(f->getType() == FOLDER); });
+
+	// the name might be new
+	if(change == FILE_METADATA_CHANGED)
+		mList.refresh(file);
+}
+
+bool BasicGameListView::isViewStyleOutdated(FileData* file)
+{
+	if(Settings::getInstance()->getString("GamelistViewStyle") != "automatic")
+		return false;
+
+	// only checks for a view style upgrade, finding out whether the last game with media lost it would take a look
+	// at every game - those views fall back to a simpler style on their next reload
+	const std::string style = getName();
+	if(mRoot->getSystem()->getTheme()->hasView("video") && !file->getVideoPath().empty())
+		return style != "video";
+
+	if(!file->getThumbnailPath().empty())
+		return style == "basic";
+
+	return false;
+}
+
 FileData* BasicGameListView::getCursor()
 {
 	return mList.getSelected();
@@ -94,7 +128,7 @@ void BasicGameListView::addPlaceholder()
 {
 	// empty list - add a placeholder
 	FileData* placeholder = new FileData(PLACEHOLDER, "<No Entries Found>", this->mRoot->getSystem()->getSystemEnvData(), this->mRoot->getSystem());
-	mList.add(placeholder->getName(), placeholder, (placeholder->getType() == PLACEHOLDER));
+	mList.add(placeholder, (placeholder->getType() == PLACEHOLDER));
 }
 
 std::string BasicGameListView::getQuickSystemSelectRightButton()
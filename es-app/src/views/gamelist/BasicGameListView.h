@@ -27,9 +27,12 @@ protected:
 	virtual std::string getQuickSystemSelectRightButton() override;
 	virtual std::string getQuickSystemSelectLeftButton() override;
 	virtual void populateList(const std::vector<FileData*>& files) override;
+	virtual void updateList(const std::vector<FileData*>& files, FileData* file, FileChangeType change) override;
 	virtual void remove(FileData* game, bool deleteFile) override;
 	virtual void addPlaceholder();
 
+	bool isViewStyleOutdated(FileData* file); // true if file's media calls for another automatic view style
+
 	TextListComponent<FileData*> mList;
 };
 
@@ -2,6 +2,8 @@
 
 #include "animations/LambdaAnimation.h"
 #include "views/ViewController.h"
+#include "Settings.h"
+#include "Window.h"
 
 DetailedGameListView::DetailedGameListView(Window* window, FileData* root) :
 	BasicGameListView(window, root),
@@ -13,7 +15,7 @@ DetailedGameListView::DetailedGameListView(Window* window, FileData* root) :
 
 	mRating(window), mReleaseDate(window), mDeveloper(window), mPublisher(window),
 	mGenre(window), mPlayers(window), mLastPlayed(window), mPlayCount(window),
-	mName(window)
+	mName(window), mInfoPanelPending(false), mInfoPanelSettleTime(0)
 {
 	//mHeaderImage.setPosition(mSize.x() * 0.25f, 0);
 
@@ -190,6 +192,25 @@ void DetailedGameListView::initMDValues()
 
 void DetailedGameListView::updateInfoPanel()
 {
+	FileData* file = (mList.size() == 0) ? NULL : mList.getSelected();
+
+	// the name is cheap, it follows the cursor right away
+	if(file != NULL)
+		mName.setValue(file->metadata.get("name"));
+
+	// everything else waits until the cursor has rested for a bit, so quickly passing through entries doesn't
+	// start image loads and description layouts that would be thrown away a moment later
+	mInfoPanelPending = true;
+	mInfoPanelSettleTime = 0;
+
+	if(file == NULL || mList.isScrolling() || Settings::getInstance()->getInt("InfoPanelSettleTime") <= 0)
+		applyInfoPanel();
+}
+
+void DetailedGameListView::applyInfoPanel()
+{
+	mInfoPanelPending = false;
+
 	FileData* file = (mList.size() == 0 || mList.isScrolling()) ? NULL : mList.getSelected();
 
 	bool fadingOut;
@@ -209,7 +230,6 @@ void DetailedGameListView::updateInfoPanel()
 		mPublisher.setValue(file->metadata.get("publisher"));
 		mGenre.setValue(file->metadata.get("genre"));
 		mPlayers.setValue(file->metadata.get("players"));
-		mName.setValue(file->metadata.get("name"));
 
 		if(file->getType() == GAME)
 		{
@@ -246,6 +266,21 @@ void DetailedGameListView::updateInfoPanel()
 	}
 }
 
+void DetailedGameListView::update(int deltaTime)
+{
+	BasicGameListView::update(deltaTime);
+
+	// while the list is scrolling fast the panel stays faded out, the settle time starts once it slows down
+	if(mInfoPanelPending && !mList.isScrolling())
+	{
+		mInfoPanelSettleTime += deltaTime;
+		if(mInfoPanelSettleTime >= Settings::getInstance()->getInt("InfoPanelSettleTime"))
+			applyInfoPanel();
+		else
+			Window::scheduleUpdate(Settings::getInstance()->getInt("InfoPanelSettleTime") - mInfoPanelSettleTime);
+	}
+}
+
 void DetailedGameListView::launch(FileData* game)
 {
 	Vector3f target(Renderer::getScreenWidth() / 2.0f, Renderer::getScreenHeight() / 2.0f, 0);
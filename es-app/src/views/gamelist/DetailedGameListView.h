@@ -18,8 +18,12 @@ public:
 
 	virtual void launch(FileData* game) override;
 
+protected:
+	virtual void update(int deltaTime) override;
+
 private:
-	void updateInfoPanel();
+	void updateInfoPanel(); // on cursor change, updates the name and schedules applyInfoPanel()
+	void applyInfoPanel(); // updates the media, description and metadata for the selected entry
 
 	void initMDLabels();
 	void initMDValues();
@@ -43,6 +47,9 @@ private:
 
 	ScrollableContainer mDescContainer;
 	TextComponent mDescription;
+
+	bool mInfoPanelPending;
+	int mInfoPanelSettleTime; // how long the cursor has rested since the last change
 };
 
 #endif // ES_APP_VIEWS_GAME_LIST_DETAILED_GAME_LIST_VIEW_H
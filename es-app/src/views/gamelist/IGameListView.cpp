@@ -42,7 +42,7 @@ HelpStyle IGameListView::getHelpStyle()
 
 void IGameListView::render(const Transform4x4f& parentTrans)
 {
-	Transform4x4f trans = parentTrans * getTransform();
+	Transform4x4f trans = getWorldTransform(parentTrans);
 
 	float scaleX = trans.r0().x();
 	float scaleY = trans.r1().y();
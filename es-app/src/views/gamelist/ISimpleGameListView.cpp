@@ -60,20 +60,14 @@ void ISimpleGameListView::onThemeChanged(const std::shared_ptr<ThemeData>& theme
 	}
 }
 
-void ISimpleGameListView::onFileChanged(FileData* /*file*/, FileChangeType /*change*/)
+void ISimpleGameListView::onFileChanged(FileData* file, FileChangeType change)
 {
-	// we could be tricky here to be efficient;
-	// but this shouldn't happen very often so we'll just always repopulate
+	// the change types callers report don't always tell the whole story (a sort can also filter, an added game
+	// can come as a metadata change), so the list is compared with what the folder shows now
 	FileData* cursor = getCursor();
-	if (!cursor->isPlaceHolder()) {
-		populateList(cursor->getParent()->getChildrenListToDisplay());
-		setCursor(cursor);
-	}
-	else
-	{
-		populateList(mRoot->getChildrenListToDisplay());
-		setCursor(cursor);
-	}
+	FileData* folder = cursor->isPlaceHolder() ? mRoot : cursor->getParent();
+	updateList(folder->getChildrenListToDisplay(), file, change);
+	setCursor(cursor);
 }
 
 bool ISimpleGameListView::input(InputConfig* config, Input input)
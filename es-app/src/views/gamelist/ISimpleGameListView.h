@@ -32,6 +32,9 @@ protected:
 	virtual std::string getQuickSystemSelectLeftButton() = 0;
 	virtual void populateList(const std::vector<FileData*>& files) = 0;
 
+	// Brings the list in line with files after file changed, views that can't do better just populate it again.
+	virtual void updateList(const std::vector<FileData*>& files, FileData* /*file*/, FileChangeType /*change*/) { populateList(files); }
+
 	TextComponent mHeaderText;
 	ImageComponent mHeaderImage;
 	ImageComponent mBackground;
@@ -7,9 +7,8 @@
 #include "components/VideoVlcComponent.h"
 #include "utils/FileSystemUtil.h"
 #include "views/ViewController.h"
-#ifdef _RPI_
 #include "Settings.h"
-#endif
+#include "Window.h"
 
 VideoGameListView::VideoGameListView(Window* window, FileData* root) :
 	BasicGameListView(window, root),
@@ -18,6 +17,8 @@ VideoGameListView::VideoGameListView(Window* window, FileData* root) :
 	mImage(window),
 	mVideo(nullptr),
 	mVideoPlaying(false),
+	mInfoPanelPending(false),
+	mInfoPanelSettleTime(0),
 
 	mLblRating(window), mLblReleaseDate(window), mLblDeveloper(window), mLblPublisher(window),
 	mLblGenre(window), mLblPlayers(window), mLblLastPlayed(window), mLblPlayCount(window),
@@ -231,6 +232,25 @@ void VideoGameListView::initMDValues()
 
 void VideoGameListView::updateInfoPanel()
 {
+	FileData* file = (mList.size() == 0) ? NULL : mList.getSelected();
+
+	// the name is cheap, it follows the cursor right away
+	if(file != NULL)
+		mName.setValue(file->metadata.get("name"));
+
+	// everything else waits until the cursor has rested for a bit, so quickly passing through entries doesn't
+	// start video, image and description loads that would be thrown away a moment later
+	mInfoPanelPending = true;
+	mInfoPanelSettleTime = 0;
+
+	if(file == NULL || mList.isScrolling() || Settings::getInstance()->getInt("InfoPanelSettleTime") <= 0)
+		applyInfoPanel();
+}
+
+void VideoGameListView::applyInfoPanel()
+{
+	mInfoPanelPending = false;
+
 	FileData* file = (mList.size() == 0 || mList.isScrolling()) ? NULL : mList.getSelected();
 
 	Utils::FileSystem::removeFile(getTitlePath());
@@ -265,7 +285,6 @@ void VideoGameListView::updateInfoPanel()
 		mPublisher.setValue(file->metadata.get("publisher"));
 		mGenre.setValue(file->metadata.get("genre"));
 		mPlayers.setValue(file->metadata.get("players"));
-		mName.setValue(file->metadata.get("name"));
 
 		if(file->getType() == GAME)
 		{
@@ -369,6 +388,17 @@ std::vector<GuiComponent*> VideoGameListView::getMDValues()
 void VideoGameListView::update(int deltaTime)
 {
 	BasicGameListView::update(deltaTime);
+
+	// while the list is scrolling fast the panel stays faded out, the settle time starts once it slows down
+	if(mInfoPanelPending && !mList.isScrolling())
+	{
+		mInfoPanelSettleTime += deltaTime;
+		if(mInfoPanelSettleTime >= Settings::getInstance()->getInt("InfoPanelSettleTime"))
+			applyInfoPanel();
+		else
+			Window::scheduleUpdate(Settings::getInstance()->getInt("InfoPanelSettleTime") - mInfoPanelSettleTime);
+	}
+
 	mVideo->update(deltaTime);
 }
 
@@ -26,7 +26,8 @@ protected:
 	virtual void update(int deltaTime) override;
 
 private:
-	void updateInfoPanel();
+	void updateInfoPanel(); // on cursor change, updates the name and schedules applyInfoPanel()
+	void applyInfoPanel(); // updates the video, media, description and metadata for the selected entry
 
 	void initMDLabels();
 	void initMDValues();
@@ -54,6 +55,8 @@ private:
 	TextComponent mDescription;
 
 	bool		mVideoPlaying;
+	bool		mInfoPanelPending;
+	int			mInfoPanelSettleTime; // how long the cursor has rested since the last change
 
 };
 
@@ -0,0 +1,129 @@
+#include "FramePacer.h"
+
+#include "Log.h"
+#include "Settings.h"
+#include <SDL_timer.h>
+#include <SDL_video.h>
+#include <algorithm>
+#include <vector>
+
+Uint64 FramePacer::mTargetFrameTime = 0;
+bool FramePacer::mLimitFPS = false;
+
+Uint64 FramePacer::mStageStart = 0;
+Uint64 FramePacer::mFrameStart = 0;
+Uint64 FramePacer::mLastFrameEnd = 0;
+Uint64 FramePacer::mNextDeadline = 0;
+bool FramePacer::mFrameEnded = false;
+
+unsigned int FramePacer::mSamples[STAGE_COUNT][SAMPLE_COUNT];
+unsigned int FramePacer::mSampleCount[STAGE_COUNT] = { 0, 0, 0, 0 };
+unsigned int FramePacer::mFrames = 0;
+unsigned int FramePacer::mLateFrames = 0;
+
+// SDL_Delay() can oversleep by about a scheduler tick, the rest is spun away
+#define SPIN_TIME 2000
+
+void FramePacer::init()
+{
+	const int maxFPS = Settings::getInstance()->getInt("MaxFPS");
+
+	mLimitFPS = maxFPS > 0;
+	mTargetFrameTime = 0;
+
+	if(mLimitFPS)
+	{
+		mTargetFrameTime = 1000000 / maxFPS;
+	}
+	else if(Settings::getInstance()->getBool("VSync"))
+	{
+		SDL_DisplayMode dispMode;
+		if(SDL_GetDesktopDisplayMode(0, &dispMode) == 0 && dispMode.refresh_rate > 0)
+			mTargetFrameTime = 1000000 / dispMode.refresh_rate;
+	}
+
+	mNextDeadline = 0;
+	mFrameEnded = false;
+}
+
+Uint64 FramePacer::now()
+{
+	// whole seconds and the remainder apart, counter * 1000000 would overflow after a few hours with a 1GHz counter
+	const Uint64 counter = SDL_GetPerformanceCounter();
+	const Uint64 frequency = SDL_GetPerformanceFrequency();
+
+	return (counter / frequency) * 1000000 + (counter % frequency) * 1000000 / frequency;
+}
+
+void FramePacer::beginFrame()
+{
+	mFrameStart = mStageStart = now();
+
+	// only frames rendered back to back say anything about pacing, not the first one after idling
+	if(!mFrameEnded)
+		mLastFrameEnd = 0;
+
+	mFrameEnded = false;
+}
+
+void FramePacer::mark(Stage stage)
+{
+	const Uint64 time = now();
+
+	mSamples[stage][mSampleCount[stage] % SAMPLE_COUNT] = (unsigned int)(time - mStageStart);
+	mSampleCount[stage]++;
+	mStageStart = time;
+}
+
+void FramePacer::endFrame()
+{
+	Uint64 time = now();
+
+	mFrames++;
+	if(mTargetFrameTime && mLastFrameEnd && (time - mLastFrameEnd) > mTargetFrameTime + mTargetFrameTime / 2)
+		mLateFrames++;
+
+	if(mLimitFPS)
+	{
+		// a frame that is way behind starts over instead of rushing the next ones to catch up,
+		// a deadline more than a frame ahead can't be right (the clock went back), so the sleep below stays bounded
+		if(mNextDeadline == 0 || time > mNextDeadline + mTargetFrameTime || mNextDeadline > time + mTargetFrameTime)
+			mNextDeadline = time;
+
+		mNextDeadline += mTargetFrameTime;
+
+		if(mNextDeadline > time + SPIN_TIME)
+			SDL_Delay((Uint32)((mNextDeadline - time - SPIN_TIME) / 1000));
+
+		while((time = now()) < mNextDeadline);
+	}
+
+	mSamples[FRAME][mSampleCount[FRAME] % SAMPLE_COUNT] = (unsigned int)(time - mFrameStart);
+	mSampleCount[FRAME]++;
+
+	mLastFrameEnd = time;
+	mFrameEnded = true;
+}
+
+void FramePacer::dumpStats()
+{
+	static const char* names[STAGE_COUNT] = { "update", "render", "swap", "frame" };
+
+	LOG(LogInfo) << "Frame times of the last " << SAMPLE_COUNT << " samples (ms):";
+
+	for(int i = 0; i < STAGE_COUNT; i++)
+	{
+		const unsigned int count = std::min(mSampleCount[i], (unsigned int)SAMPLE_COUNT);
+		if(count == 0)
+			continue;
+
+		std::vector<unsigned int> samples(mSamples[i], mSamples[i] + count);
+		std::sort(samples.begin(), samples.end());
+
+		const auto percentile = [&samples](const unsigned int p) { return samples[(samples.size() - 1) * p / 100] / 1000.0f; };
+
+		LOG(LogInfo) << "  " << names[i] << ": p50 " << percentile(50) << " p95 " << percentile(95) << " p99 " << percentile(99) << " max " << samples.back() / 1000.0f;
+	}
+
+	LOG(LogInfo) << "  late frames: " << mLateFrames << " of " << mFrames << " rendered (target " << mTargetFrameTime / 1000.0f << "ms)";
+}
@@ -0,0 +1,47 @@
+#pragma once
+#ifndef ES_CORE_FRAME_PACER_H
+#define ES_CORE_FRAME_PACER_H
+
+#include <SDL_stdinc.h>
+
+// Times the stages of the main loop and paces rendered frames to MaxFPS.
+// The last SAMPLE_COUNT times of every stage are kept for the percentiles dumpStats() logs.
+// A rendered frame that follows another one is late when it took more than 1.5 frames of the target,
+// which is MaxFPS or, with VSync, the refresh rate of the display.
+class FramePacer
+{
+public:
+	enum Stage { UPDATE = 0, RENDER = 1, SWAP = 2, FRAME = 3, STAGE_COUNT = 4 };
+
+	static const int SAMPLE_COUNT = 1000;
+
+	// Call when the window gets (re)initialized or after MaxFPS or VSync changed
+	static void init();
+
+	// Paired calls around every loop iteration, mark() ends a stage and starts the next one
+	static void beginFrame();
+	static void mark(Stage stage);
+	// For rendered frames only, after swapBuffers(), sleeps if the frame was early
+	static void endFrame();
+
+	static void dumpStats();
+
+private:
+	static Uint64 now(); // in microseconds
+
+	static Uint64 mTargetFrameTime; // 0 for none
+	static bool mLimitFPS;
+
+	static Uint64 mStageStart;
+	static Uint64 mFrameStart;
+	static Uint64 mLastFrameEnd;
+	static Uint64 mNextDeadline;
+	static bool mFrameEnded; // the previous iteration rendered a frame
+
+	static unsigned int mSamples[STAGE_COUNT][SAMPLE_COUNT];
+	static unsigned int mSampleCount[STAGE_COUNT];
+	static unsigned int mFrames;
+	static unsigned int mLateFrames;
+};
+
+#endif // ES_CORE_FRAME_PACER_H
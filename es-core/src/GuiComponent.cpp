@@ -10,7 +10,10 @@
 
 GuiComponent::GuiComponent(Window* window) : mWindow(window), mParent(NULL), mOpacity(255),
 	mPosition(Vector3f::Zero()), mOrigin(Vector2f::Zero()), mRotationOrigin(0.5, 0.5),
-	mSize(Vector2f::Zero()), mTransform(Transform4x4f::Identity()), mIsProcessing(false), mVisible(true)
+	mSize(Vector2f::Zero()), mTransform(Transform4x4f::Identity()), mIsProcessing(false), mVisible(true),
+	mWorldTransform(Transform4x4f::Identity()), mWorldParentTransform(Transform4x4f::Identity()),
+	mTransformSize(Vector2f::Zero()), mTransformRotationSize(Vector2f::Zero()), mTransformDirty(true), mWorldTransformDirty(true),
+	mUpdateRequested(false), mAnimating(false), mUpdateCount(0)
 {
 	for(unsigned char i = 0; i < MAX_ANIMATIONS; i++)
 		mAnimationMap[i] = NULL;
@@ -43,14 +46,17 @@ bool GuiComponent::input(InputConfig* config, Input input)
 void GuiComponent::updateSelf(int deltaTime)
 {
 	for(unsigned char i = 0; i < MAX_ANIMATIONS; i++)
-		advanceAnimation(i, deltaTime);
+	{
+		if(advanceAnimation(i, deltaTime))
+			Window::invalidate();
+	}
 }
 
 void GuiComponent::updateChildren(int deltaTime)
 {
 	for(unsigned int i = 0; i < getChildCount(); i++)
 	{
-		getChild(i)->update(deltaTime);
+		getChild(i)->tick(deltaTime);
 	}
 }
 
@@ -60,12 +66,58 @@ void GuiComponent::update(int deltaTime)
 	updateChildren(deltaTime);
 }
 
+void GuiComponent::tick(int deltaTime)
+{
+	if(mUpdateCount == 0)
+		return;
+
+	// cleared before update(), which can delete us
+	if(mUpdateRequested)
+	{
+		mUpdateRequested = false;
+		addUpdateCount(-1);
+	}
+
+	update(deltaTime);
+}
+
+void GuiComponent::requestUpdate()
+{
+	if(mUpdateRequested)
+		return;
+
+	mUpdateRequested = true;
+	addUpdateCount(1);
+}
+
+void GuiComponent::addUpdateCount(int count)
+{
+	for(GuiComponent* cmp = this; cmp != NULL; cmp = cmp->mParent)
+		cmp->mUpdateCount += count;
+}
+
+void GuiComponent::updateAnimating()
+{
+	bool animating = false;
+	for(unsigned char i = 0; i < MAX_ANIMATIONS; i++)
+	{
+		if(mAnimationMap[i])
+			animating = true;
+	}
+
+	if(animating != mAnimating)
+	{
+		mAnimating = animating;
+		addUpdateCount(animating ? 1 : -1);
+	}
+}
+
 void GuiComponent::render(const Transform4x4f& parentTrans)
 {
 	if (!isVisible())
 		return;
 
-	Transform4x4f trans = parentTrans * getTransform();
+	Transform4x4f trans = getWorldTransform(parentTrans);
 	renderChildren(trans);
 }
 
@@ -73,7 +125,9 @@ void GuiComponent::renderChildren(const Transform4x4f& transform) const
 {
 	for(unsigned int i = 0; i < getChildCount(); i++)
 	{
-		getChild(i)->render(transform);
+		GuiComponent* child = getChild(i);
+		if(!child->isCulled(transform))
+			child->render(transform);
 	}
 }
 
@@ -84,7 +138,11 @@ Vector3f GuiComponent::getPosition() const
 
 void GuiComponent::setPosition(float x, float y, float z)
 {
+	if(mPosition != Vector3f(x, y, z))
+		Window::invalidate();
+
 	mPosition = Vector3f(x, y, z);
+	mTransformDirty = true;
 	onPositionChanged();
 }
 
@@ -95,7 +153,11 @@ Vector2f GuiComponent::getOrigin() const
 
 void GuiComponent::setOrigin(float x, float y)
 {
+	if(mOrigin != Vector2f(x, y))
+		Window::invalidate();
+
 	mOrigin = Vector2f(x, y);
+	mTransformDirty = true;
 	onOriginChanged();
 }
 
@@ -106,7 +168,11 @@ Vector2f GuiComponent::getRotationOrigin() const
 
 void GuiComponent::setRotationOrigin(float x, float y)
 {
+	if(mRotationOrigin != Vector2f(x, y))
+		Window::invalidate();
+
 	mRotationOrigin = Vector2f(x, y);
+	mTransformDirty = true;
 }
 
 Vector2f GuiComponent::getSize() const
@@ -116,6 +182,9 @@ Vector2f GuiComponent::getSize() const
 
 void GuiComponent::setSize(float w, float h)
 {
+	if(mSize != Vector2f(w, h))
+		Window::invalidate();
+
 	mSize = Vector2f(w, h);
     onSizeChanged();
 }
@@ -127,7 +196,11 @@ float GuiComponent::getRotation() const
 
 void GuiComponent::setRotation(float rotation)
 {
+	if(mRotation != rotation)
+		Window::invalidate();
+
 	mRotation = rotation;
+	mTransformDirty = true;
 }
 
 float GuiComponent::getScale() const
@@ -137,7 +210,11 @@ float GuiComponent::getScale() const
 
 void GuiComponent::setScale(float scale)
 {
+	if(mScale != scale)
+		Window::invalidate();
+
 	mScale = scale;
+	mTransformDirty = true;
 }
 
 float GuiComponent::getZIndex() const
@@ -166,6 +243,9 @@ bool GuiComponent::isVisible() const
 }
 void GuiComponent::setVisible(bool visible)
 {
+	if(mVisible != visible)
+		Window::invalidate();
+
 	mVisible = visible;
 }
 
@@ -232,7 +312,16 @@ GuiComponent* GuiComponent::getChild(unsigned int i) const
 
 void GuiComponent::setParent(GuiComponent* parent)
 {
+	// our subtree's update needs move along with us
+	if(mParent && mUpdateCount)
+		mParent->addUpdateCount(-mUpdateCount);
+
 	mParent = parent;
+
+	if(mParent && mUpdateCount)
+		mParent->addUpdateCount(mUpdateCount);
+
+	mWorldTransformDirty = true;
 }
 
 GuiComponent* GuiComponent::getParent() const
@@ -247,6 +336,9 @@ unsigned char GuiComponent::getOpacity() const
 
 void GuiComponent::setOpacity(unsigned char opacity)
 {
+	if(mOpacity != opacity)
+		Window::invalidate();
+
 	mOpacity = opacity;
 	for(auto it = mChildren.cbegin(); it != mChildren.cend(); it++)
 	{
@@ -256,6 +348,13 @@ void GuiComponent::setOpacity(unsigned char opacity)
 
 const Transform4x4f& GuiComponent::getTransform()
 {
+	const Vector2f rotationSize = (mRotation != 0.0) ? getRotationSize() : Vector2f::Zero();
+	if(!mTransformDirty && mSize == mTransformSize && rotationSize == mTransformRotationSize)
+	{
+		Renderer::countTransform(Renderer::TransformOp::REUSED);
+		return mTransform;
+	}
+
 	mTransform = Transform4x4f::Identity();
 	mTransform.translate(mPosition);
 	if (mScale != 1.0)
@@ -265,7 +364,6 @@ const Transform4x4f& GuiComponent::getTransform()
 	if (mRotation != 0.0)
 	{
 		// Calculate offset as difference between origin and rotation origin
-		Vector2f rotationSize = getRotationSize();
 		float xOff = (mOrigin.x() - mRotationOrigin.x()) * rotationSize.x();
 		float yOff = (mOrigin.y() - mRotationOrigin.y()) * rotationSize.y();
 
@@ -281,9 +379,69 @@ const Transform4x4f& GuiComponent::getTransform()
 			mTransform.translate(Vector3f(xOff, yOff, 0.0f));
 	}
 	mTransform.translate(Vector3f(mOrigin.x() * mSize.x() * -1, mOrigin.y() * mSize.y() * -1, 0.0f));
+
+	mTransformSize         = mSize;
+	mTransformRotationSize = rotationSize;
+	mTransformDirty        = false;
+	mWorldTransformDirty   = true;
+
+	Renderer::countTransform(Renderer::TransformOp::BUILT);
 	return mTransform;
 }
 
+bool GuiComponent::isCulled(const Transform4x4f& parentTrans)
+{
+	if(!isVisible())
+	{
+		Renderer::countComponent(true);
+		return true;
+	}
+
+	// nothing to test against, the children can still draw anywhere
+	if(mSize.x() == 0 || mSize.y() == 0)
+	{
+		Renderer::countComponent(false);
+		return false;
+	}
+
+	// bounding box of the transformed corners, so scaled and rotated components work as well
+	const Transform4x4f& trans = getWorldTransform(parentTrans);
+	const Vector3f corners[4] = { trans * Vector3f(0, 0, 0), trans * Vector3f(mSize.x(), 0, 0),
+	                              trans * Vector3f(0, mSize.y(), 0), trans * Vector3f(mSize.x(), mSize.y(), 0) };
+
+	Vector2f topLeft(corners[0].x(), corners[0].y());
+	Vector2f bottomRight(topLeft);
+	for(int i = 1; i < 4; i++)
+	{
+		topLeft     = Vector2f(Math::min(topLeft.x(), corners[i].x()), Math::min(topLeft.y(), corners[i].y()));
+		bottomRight = Vector2f(Math::max(bottomRight.x(), corners[i].x()), Math::max(bottomRight.y(), corners[i].y()));
+	}
+
+	const Renderer::Rect clip = Renderer::getClipRect();
+	const bool culled = (bottomRight.x() <= clip.x) || (bottomRight.y() <= clip.y) ||
+	                    (topLeft.x() >= (clip.x + clip.w)) || (topLeft.y() >= (clip.y + clip.h));
+
+	Renderer::countComponent(culled);
+	return culled;
+}
+
+const Transform4x4f& GuiComponent::getWorldTransform(const Transform4x4f& parentTrans)
+{
+	const Transform4x4f& trans = getTransform();
+	if(!mWorldTransformDirty && parentTrans == mWorldParentTransform)
+	{
+		Renderer::countTransform(Renderer::TransformOp::REUSED);
+		return mWorldTransform;
+	}
+
+	mWorldTransform       = parentTrans * trans;
+	mWorldParentTransform = parentTrans;
+	mWorldTransformDirty  = false;
+
+	Renderer::countTransform(Renderer::TransformOp::MULTIPLIED);
+	return mWorldTransform;
+}
+
 void GuiComponent::setValue(const std::string& /*value*/)
 {
 }
@@ -310,6 +468,8 @@ void GuiComponent::setAnimation(Animation* anim, int delay, std::function<void()
 
 	if(oldAnim)
 		delete oldAnim;
+
+	updateAnimating();
 }
 
 bool GuiComponent::stopAnimation(unsigned char slot)
@@ -319,6 +479,7 @@ bool GuiComponent::stopAnimation(unsigned char slot)
 	{
 		delete mAnimationMap[slot];
 		mAnimationMap[slot] = NULL;
+		updateAnimating();
 		return true;
 	}else{
 		return false;
@@ -333,6 +494,7 @@ bool GuiComponent::cancelAnimation(unsigned char slot)
 		mAnimationMap[slot]->removeFinishedCallback();
 		delete mAnimationMap[slot];
 		mAnimationMap[slot] = NULL;
+		updateAnimating();
 		return true;
 	}else{
 		return false;
@@ -350,6 +512,7 @@ bool GuiComponent::finishAnimation(unsigned char slot)
 
 		delete mAnimationMap[slot]; // will also call finishedCallback
 		mAnimationMap[slot] = NULL;
+		updateAnimating();
 		return true;
 	}else{
 		return false;
@@ -367,6 +530,7 @@ bool GuiComponent::advanceAnimation(unsigned char slot, unsigned int time)
 		{
 			mAnimationMap[slot] = NULL;
 			delete anim;
+			updateAnimating();
 		}
 		return true;
 	}else{
@@ -30,11 +30,18 @@ public:
 	virtual bool input(InputConfig* config, Input input);
 
 	//Called when time passes.  Default implementation calls updateSelf(deltaTime) and updateChildren(deltaTime) - so you should probably call GuiComponent::update(deltaTime) at some point (or at least updateSelf so animations work).
+	//Children only get updated while they need it, see tick().
 	virtual void update(int deltaTime);
 
-	//Called when it's time to render.  By default, just calls renderChildren(parentTrans * getTransform()).
+	// Calls update() if this component or one of its children needs it, otherwise the whole subtree is skipped.
+	// A playing animation keeps a component ticking, anything else (scrolling, videos, timers) asks with requestUpdate().
+	void tick(int deltaTime);
+	void requestUpdate(); // only holds for the next tick, call it again from update() to keep ticking
+	inline bool isUpdateNeeded() const { return mUpdateCount > 0; }
+
+	//Called when it's time to render.  By default, just calls renderChildren(getWorldTransform(parentTrans)).
 	//You probably want to override this like so:
-	//1. Calculate the new transform that your control will draw at with Transform4x4f t = parentTrans * getTransform().
+	//1. Calculate the new transform that your control will draw at with Transform4x4f t = getWorldTransform(parentTrans).
 	//2. Set the renderer to use that new transform as the model matrix - Renderer::setMatrix(t);
 	//3. Draw your component.
 	//4. Tell your children to render, based on your component's transform - renderChildren(t).
@@ -107,7 +114,15 @@ public:
 	virtual unsigned char getOpacity() const;
 	virtual void setOpacity(unsigned char opacity);
 
+	// Both are cached, the local transform is rebuilt when position, origin, size, rotation or scale change
+	// and the world transform when the local one or the parent's transform does.
 	const Transform4x4f& getTransform();
+	const Transform4x4f& getWorldTransform(const Transform4x4f& parentTrans); // parentTrans * getTransform()
+
+	// Returns true if rendering at parentTrans would draw nothing: hidden, or the bounding box is completely outside
+	// the current clip rect (the screen if nothing is clipped). Components without a size are never culled.
+	// A component's children are expected to draw within its bounds, the whole subtree is skipped.
+	bool isCulled(const Transform4x4f& parentTrans);
 
 	virtual std::string getValue() const;
 	virtual void setValue(const std::string& value);
@@ -167,7 +182,20 @@ public:
 
 private:
 	Transform4x4f mTransform; //Don't access this directly! Use getTransform()!
+	Transform4x4f mWorldTransform; // same, use getWorldTransform()
+	Transform4x4f mWorldParentTransform; // what mWorldTransform was built from
+	Vector2f mTransformSize; // derived components write mSize directly, so a size change is detected rather than flagged
+	Vector2f mTransformRotationSize;
+	bool mTransformDirty;
+	bool mWorldTransformDirty;
 	AnimationController* mAnimationMap[MAX_ANIMATIONS];
+
+	void addUpdateCount(int count); // to this component and all of its parents
+	void updateAnimating();
+
+	bool mUpdateRequested;
+	bool mAnimating; // any slot of mAnimationMap is in use
+	int mUpdateCount; // components of this subtree (itself included) that requested an update or are animating
 };
 
 #endif // ES_CORE_GUI_COMPONENT_H
@@ -33,7 +33,9 @@ std::vector<const char*> settings_dont_save {
 	{ "ScreenHeight" },
 	{ "ScreenOffsetX" },
 	{ "ScreenOffsetY" },
-	{ "ScreenRotate" }
+	{ "ScreenRotate" },
+	{ "FrameCapturePath" },
+	{ "FrameStatsFile" }
 };
 
 Settings::Settings()
@@ -67,6 +69,8 @@ void Settings::setDefaults()
 	mStringMap["StartupSystem"] = "";
 
 	mBoolMap["VSync"] = true;
+	mBoolMap["RenderOnDemand"] = true; // only render frames when something on screen changed
+	mBoolMap["ThreadedRendering"] = false; // submit each frame to the backend on a render thread while the next one is built
 
 	mBoolMap["EnableSounds"] = true;
 	mBoolMap["ShowHelpPrompts"] = true;
@@ -84,6 +88,8 @@ void Settings::setDefaults()
 	mIntMap["ScreenSaverTime"] = 5*60*1000; // 5 minutes
 	mIntMap["ScraperResizeWidth"] = 400;
 	mIntMap["ScraperResizeHeight"] = 0;
+	mIntMap["MaxFPS"] = 0; // frames rendered per second at most, 0 = as many as VSync allows
+	mIntMap["InfoPanelSettleTime"] = 150; // ms the gamelist cursor has to rest before the detail panel loads media, 0 = immediately
 	#ifdef _RPI_
 		mIntMap["MaxVRAM"] = 80;
 	#else
@@ -160,6 +166,9 @@ void Settings::setDefaults()
 	mIntMap["ScreenOffsetX"] = 0;
 	mIntMap["ScreenOffsetY"] = 0;
 	mIntMap["ScreenRotate"]  = 0;
+
+	mStringMap["FrameCapturePath"] = ""; // only used by the headless renderer
+	mStringMap["FrameStatsFile"] = ""; // CSV file the renderer writes its per frame stats to
 }
 
 template <typename K, typename V>
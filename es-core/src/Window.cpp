@@ -2,13 +2,25 @@
 
 #include "components/HelpComponent.h"
 #include "components/ImageComponent.h"
+#include "renderers/Renderer.h"
 #include "resources/Font.h"
+#include "resources/GlyphAtlas.h"
 #include "resources/TextureResource.h"
+#include "FramePacer.h"
 #include "InputManager.h"
 #include "Log.h"
 #include "Scripting.h"
 #include <algorithm>
 #include <iomanip>
+#include <SDL_events.h>
+#include <SDL_timer.h>
+
+#define IDLE_UPDATE_TIME 250 // ms between updates when nothing is going on, for timers (screensaver, video looping, ...)
+#define SLEEP_WAIT_TIME 1000 // only input wakes us up while sleeping
+
+std::atomic<bool> Window::sInvalidated(true);
+unsigned int      Window::sNextUpdate = 0;
+unsigned int      Window::sWakeEvent = 0;
 
 Window::Window() : mNormalizeNextUpdate(false), mFrameTimeElapsed(0), mFrameCountElapsed(0), mAverageDeltaTime(10),
 	mAllowSleep(true), mSleeping(false), mTimeSinceLastInput(0), mScreenSaver(NULL), mRenderScreenSaver(false), mInfoPopup(NULL)
@@ -37,6 +49,7 @@ void Window::pushGui(GuiComponent* gui)
 	}
 	mGuiStack.push_back(gui);
 	gui->updateHelpPrompts();
+	invalidate();
 }
 
 void Window::removeGui(GuiComponent* gui)
@@ -53,6 +66,7 @@ void Window::removeGui(GuiComponent* gui)
 				mGuiStack.back()->topWindow(true);
 			}
 
+			invalidate();
 			return;
 		}
 	}
@@ -75,6 +89,10 @@ bool Window::init()
 	}
 
 	InputManager::getInstance()->init();
+	FramePacer::init();
+
+	if(sWakeEvent == 0)
+		sWakeEvent = SDL_RegisterEvents(1);
 
 	ResourceManager::getInstance()->reloadAll();
 
@@ -93,6 +111,7 @@ bool Window::init()
 	if(peekGui())
 		peekGui()->updateHelpPrompts();
 
+	invalidate();
 	return true;
 }
 
@@ -110,12 +129,16 @@ void Window::deinit()
 
 void Window::textInput(const char* text)
 {
+	invalidate();
+
 	if(peekGui())
 		peekGui()->textInput(text);
 }
 
 void Window::input(InputConfig* config, Input input)
 {
+	invalidate();
+
 	if (mScreenSaver) {
 		if(mScreenSaver->isScreenSaverActive() && Settings::getInstance()->getBool("ScreenSaverControls") &&
 		   (Settings::getInstance()->getString("ScreenSaverBehavior") == "random video"))
@@ -171,6 +194,11 @@ void Window::input(InputConfig* config, Input input)
 		// toggle TextComponent debug view with Ctrl-I
 		Settings::getInstance()->setBool("DebugImage", !Settings::getInstance()->getBool("DebugImage"));
 	}
+	else if(config->getDeviceId() == DEVICE_KEYBOARD && input.value && input.id == SDLK_p && SDL_GetModState() & KMOD_LCTRL && Settings::getInstance()->getBool("Debug"))
+	{
+		// log frame time percentiles with Ctrl-P
+		FramePacer::dumpStats();
+	}
 	else
 	{
 		if (peekGui())
@@ -189,6 +217,9 @@ void Window::update(int deltaTime)
 			deltaTime = mAverageDeltaTime;
 	}
 
+	// components schedule their next update again while they're updated
+	sNextUpdate = 0;
+
 	mFrameTimeElapsed += deltaTime;
 	mFrameCountElapsed++;
 	if(mFrameTimeElapsed > 500)
@@ -206,10 +237,21 @@ void Window::update(int deltaTime)
 			// vram
 			float textureVramUsageMb = TextureResource::getTotalMemUsage() / 1000.0f / 1000.0f;
 			float textureTotalUsageMb = TextureResource::getTotalTextureSize() / 1000.0f / 1000.0f;
-			float fontVramUsageMb = Font::getTotalMemUsage() / 1000.0f / 1000.0f;
+			float fontVramUsageMb = GlyphAtlas::getInstance()->getMemUsage() / 1000.0f / 1000.0f;
 
 			ss << "\nFont VRAM: " << fontVramUsageMb << " Tex VRAM: " << textureVramUsageMb <<
 				  " Tex Max: " << textureTotalUsageMb;
+
+			// renderer stats of the last frame
+			const Renderer::FrameStats& stats = Renderer::getFrameStats();
+			ss << "\nDraws: " << stats.drawCalls << " Batches: " << stats.batches << " Vertices: " << stats.vertices <<
+				  " Binds: " << stats.textureBinds << " Clips: " << stats.clipPushes;
+			ss << "\nState changes: " << stats.stateChanges << " Skipped: " << stats.skippedStateChanges <<
+				  " Uploads: " << stats.uploads << " (" << (stats.uploadBytes / 1000) << " KB)";
+			ss << "\nText caches built: " << stats.textCachesBuilt << " Textures decoded: " << stats.texturesDecoded;
+			ss << "\nTransforms built: " << stats.transformsBuilt << " Multiplied: " << stats.transformsMultiplied <<
+				  " Reused: " << stats.transformsReused;
+			ss << "\nComponents drawn: " << stats.componentsDrawn << " Culled: " << stats.componentsCulled;
 			mFrameDataText = std::unique_ptr<TextCache>(mDefaultFonts.at(1)->buildTextCache(ss.str(), 50.f, 50.f, 0xFF00FFFF));
 		}
 
@@ -217,6 +259,10 @@ void Window::update(int deltaTime)
 		mFrameCountElapsed = 0;
 	}
 
+	// the framerate display is only meaningful if every update gets rendered
+	if(Settings::getInstance()->getBool("DrawFramerate"))
+		invalidate();
+
 	mTimeSinceLastInput += deltaTime;
 
 	if(peekGui())
@@ -225,12 +271,31 @@ void Window::update(int deltaTime)
 	// Update the screensaver
 	if (mScreenSaver)
 		mScreenSaver->update(deltaTime);
+
+	// checked here rather than in render(), nothing gets rendered while the screen doesn't change
+	unsigned int screensaverTime = (unsigned int)Settings::getInstance()->getInt("ScreenSaverTime");
+	if(mTimeSinceLastInput >= screensaverTime && screensaverTime != 0)
+	{
+		startScreenSaver();
+
+		if (!isProcessing() && mAllowSleep && (!mScreenSaver || mScreenSaver->allowSleep()))
+		{
+			// go to sleep
+			if (mSleeping == false) {
+				mSleeping = true;
+				onSleep();
+			}
+		}
+	}
 }
 
 void Window::render()
 {
 	Transform4x4f transform = Transform4x4f::Identity();
 
+	GlyphAtlas::getInstance()->nextFrame();
+	Font::processRasterizedGlyphs();
+
 	mRenderedHelpPrompts = false;
 
 	// draw only bottom and top of GuiStack (if they are different)
@@ -256,10 +321,6 @@ void Window::render()
 		mDefaultFonts.at(1)->renderTextCache(mFrameDataText.get());
 	}
 
-	unsigned int screensaverTime = (unsigned int)Settings::getInstance()->getInt("ScreenSaverTime");
-	if(mTimeSinceLastInput >= screensaverTime && screensaverTime != 0)
-		startScreenSaver();
-
 	// Always call the screensaver render function regardless of whether the screensaver is active
 	// or not because it may perform a fade on transition
 	renderScreenSaver();
@@ -268,18 +329,6 @@ void Window::render()
 	{
 		mInfoPopup->render(transform);
 	}
-
-	if(mTimeSinceLastInput >= screensaverTime && screensaverTime != 0)
-	{
-		if (!isProcessing() && mAllowSleep && (!mScreenSaver || mScreenSaver->allowSleep()))
-		{
-			// go to sleep
-			if (mSleeping == false) {
-				mSleeping = true;
-				onSleep();
-			}
-		}
-	}
 }
 
 void Window::normalizeNextUpdate()
@@ -423,6 +472,7 @@ void Window::startScreenSaver()
 
 		mScreenSaver->startScreenSaver();
 		mRenderScreenSaver = true;
+		invalidate();
 	}
 }
 
@@ -438,6 +488,7 @@ bool Window::cancelScreenSaver()
 		for(auto i = mGuiStack.cbegin(); i != mGuiStack.cend(); i++)
 			(*i)->onScreenSaverDeactivate();
 
+		invalidate();
 		return true;
 	}
 
@@ -449,3 +500,48 @@ void Window::renderScreenSaver()
 	if (mScreenSaver)
 		mScreenSaver->renderScreenSaver();
 }
+
+void Window::invalidate()
+{
+	sInvalidated = true;
+}
+
+void Window::wake()
+{
+	sInvalidated = true;
+
+	// SDL_PushEvent() is safe to call from any thread
+	if(sWakeEvent != 0 && sWakeEvent != (unsigned int)-1)
+	{
+		SDL_Event event;
+		event.type = sWakeEvent;
+		SDL_PushEvent(&event);
+	}
+}
+
+void Window::scheduleUpdate(int delay)
+{
+	const unsigned int time = SDL_GetTicks() + Math::max(delay, 0);
+	if(sNextUpdate == 0 || time < sNextUpdate)
+		sNextUpdate = time;
+}
+
+bool Window::validate()
+{
+	return sInvalidated.exchange(false);
+}
+
+int Window::getIdleTimeout()
+{
+	if(mSleeping)
+		return SLEEP_WAIT_TIME;
+
+	if(sInvalidated)
+		return 0;
+
+	if(sNextUpdate == 0)
+		return IDLE_UPDATE_TIME;
+
+	const int untilUpdate = (int)(sNextUpdate - SDL_GetTicks());
+	return Math::max(Math::min(untilUpdate, IDLE_UPDATE_TIME), 0);
+}
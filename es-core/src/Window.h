@@ -6,6 +6,7 @@
 #include "InputConfig.h"
 #include "Settings.h"
 
+#include <atomic>
 #include <memory>
 
 class FileData;
@@ -77,6 +78,14 @@ public:
 	bool cancelScreenSaver();
 	void renderScreenSaver();
 
+	// Render on demand: the main loop only renders a frame if something invalidated the screen since the last one.
+	// Anything that changes what's on screen outside of input (animations, video frames, async loads) has to say so.
+	static void invalidate();
+	static void wake(); // invalidate() for other threads, also interrupts the main loop if it's waiting for events
+	static void scheduleUpdate(int delay); // update() has to run again within delay ms, even if nothing invalidates until then
+	static bool validate(); // returns true if the screen was invalidated, and resets it for the next frame
+	int getIdleTimeout(); // how long the main loop can wait for events before the next update is due (in ms)
+
 private:
 	void onSleep();
 	void onWake();
@@ -107,6 +116,10 @@ private:
 	unsigned int mTimeSinceLastInput;
 
 	bool mRenderedHelpPrompts;
+
+	static std::atomic<bool> sInvalidated;
+	static unsigned int      sNextUpdate;
+	static unsigned int      sWakeEvent;
 };
 
 #endif // ES_CORE_WINDOW_H
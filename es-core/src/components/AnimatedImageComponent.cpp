@@ -3,6 +3,7 @@
 #include "components/ImageComponent.h"
 #include "resources/ResourceManager.h"
 #include "Log.h"
+#include "Window.h"
 
 AnimatedImageComponent::AnimatedImageComponent(Window* window) : GuiComponent(window), mEnabled(false)
 {
@@ -34,6 +35,7 @@ void AnimatedImageComponent::load(const AnimationDef* def)
 	mCurrentFrame = 0;
 	mFrameAccumulator = 0;
 	mEnabled = true;
+	requestUpdate();
 }
 
 void AnimatedImageComponent::reset()
@@ -76,6 +78,13 @@ void AnimatedImageComponent::update(int deltaTime)
 		}
 
 		mFrameAccumulator -= mFrames.at(mCurrentFrame).second;
+		Window::invalidate();
+	}
+
+	if(mEnabled)
+	{
+		Window::scheduleUpdate(mFrames.at(mCurrentFrame).second - mFrameAccumulator);
+		requestUpdate();
 	}
 }
 
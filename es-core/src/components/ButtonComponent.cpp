@@ -42,7 +42,7 @@ void ButtonComponent::setText(const std::string& text, const std::string& helpTe
 	mText = Utils::String::toUpper(text);
 	mHelpText = helpText;
 
-	mTextCache = std::unique_ptr<TextCache>(mFont->buildTextCache(mText, 0, 0, getCurTextColor()));
+	mTextCache = mFont->getTextCache(mText);
 
 	float minWidth = mFont->sizeText("DELETE").x() + 12;
 	setSize(Math::max(mTextCache->metrics.size.x() + 12, minWidth), mTextCache->metrics.size.y());
@@ -85,7 +85,7 @@ void ButtonComponent::updateImage()
 
 void ButtonComponent::render(const Transform4x4f& parentTrans)
 {
-	Transform4x4f trans = parentTrans * getTransform();
+	Transform4x4f trans = getWorldTransform(parentTrans);
 
 	mBox.render(trans);
 
@@ -95,8 +95,7 @@ void ButtonComponent::render(const Transform4x4f& parentTrans)
 		trans = trans.translate(centerOffset);
 
 		Renderer::setMatrix(trans);
-		mTextCache->setColor(getCurTextColor());
-		mFont->renderTextCache(mTextCache.get());
+		mFont->renderTextCache(mTextCache.get(), getCurTextColor());
 		trans = trans.translate(-centerOffset);
 	}
 
@@ -44,7 +44,7 @@ private:
 
 	std::string mText;
 	std::string mHelpText;
-	std::unique_ptr<TextCache> mTextCache;
+	std::shared_ptr<TextCache> mTextCache;
 	NinePatchComponent mBox;
 };
 
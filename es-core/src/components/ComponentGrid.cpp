@@ -1,11 +1,12 @@
 #include "components/ComponentGrid.h"
 
 #include "Settings.h"
+#include "Window.h"
 
 using namespace GridFlags;
 
 ComponentGrid::ComponentGrid(Window* window, const Vector2i& gridDimensions) : GuiComponent(window),
-	mGridSize(gridDimensions), mCursor(0, 0)
+	mLayoutDirty(false), mGridSize(gridDimensions), mCursor(0, 0)
 {
 	assert(gridDimensions.x() > 0 && gridDimensions.y() > 0);
 
@@ -100,8 +101,7 @@ void ComponentGrid::setEntry(const std::shared_ptr<GuiComponent>& comp, const Ve
 		onCursorMoved(origCursor, mCursor);
 	}
 
-	updateCellComponent(mCells.back());
-	updateSeparators();
+	onSizeChanged();
 }
 
 bool ComponentGrid::removeEntry(const std::shared_ptr<GuiComponent>& comp)
@@ -197,6 +197,18 @@ void ComponentGrid::updateSeparators()
 
 void ComponentGrid::onSizeChanged()
 {
+	// menus add their rows one at a time, only the last layout would be seen anyway
+	mLayoutDirty = true;
+	Window::invalidate();
+}
+
+void ComponentGrid::layout()
+{
+	if(!mLayoutDirty)
+		return;
+
+	mLayoutDirty = false;
+
 	for(auto it = mCells.cbegin(); it != mCells.cend(); it++)
 		updateCellComponent(*it);
 
@@ -343,18 +355,22 @@ bool ComponentGrid::cursorValid()
 
 void ComponentGrid::update(int deltaTime)
 {
+	layout();
+
 	// update ALL THE THINGS
 	const GridEntry* cursorEntry = getCellAt(mCursor);
 	for(auto it = mCells.cbegin(); it != mCells.cend(); it++)
 	{
 		if(it->updateType == UPDATE_ALWAYS || (it->updateType == UPDATE_WHEN_SELECTED && cursorEntry == &(*it)))
-			it->component->update(deltaTime);
+			it->component->tick(deltaTime);
 	}
 }
 
 void ComponentGrid::render(const Transform4x4f& parentTrans)
 {
-	Transform4x4f trans = parentTrans * getTransform();
+	layout();
+
+	Transform4x4f trans = getWorldTransform(parentTrans);
 
 	renderChildren(trans);
 
@@ -27,6 +27,7 @@ namespace GridFlags
 };
 
 // Used to arrange a bunch of components in a spreadsheet-esque grid.
+// Adding entries and changing sizes only marks the layout dirty, the cells are laid out once before the next update or render.
 class ComponentGrid : public GuiComponent
 {
 public:
@@ -44,14 +45,17 @@ public:
 	void render(const Transform4x4f& parentTrans) override;
 	void onSizeChanged() override;
 
+	// lays out the cells now if anything changed, for when the size of a cell's component is needed right away
+	void layout();
+
 	void resetCursor();
 	bool cursorValid();
 
 	float getColWidth(int col);
 	float getRowHeight(int row);
 
-	void setColWidthPerc(int col, float width, bool update = true); // if update is false, will not call an onSizeChanged() which triggers a (potentially costly) repositioning + resizing of every element
-	void setRowHeightPerc(int row, float height, bool update = true); // if update is false, will not call an onSizeChanged() which triggers a (potentially costly) repositioning + resizing of every element
+	void setColWidthPerc(int col, float width, bool update = true); // if update is false, will not call an onSizeChanged() which marks the layout dirty
+	void setRowHeightPerc(int row, float height, bool update = true); // if update is false, will not call an onSizeChanged() which marks the layout dirty
 
 	bool moveCursor(Vector2i dir);
 	void setCursorTo(const std::shared_ptr<GuiComponent>& comp);
@@ -98,6 +102,7 @@ private:
 	float* mColWidths;
 
 	std::vector<Renderer::Vertex> mLines;
+	bool mLayoutDirty;
 
 	// Update position & size
 	void updateCellComponent(const GridEntry& cell);
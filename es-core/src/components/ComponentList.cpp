@@ -1,5 +1,7 @@
 #include "components/ComponentList.h"
 
+#include "Window.h"
+
 #define TOTAL_HORIZONTAL_PADDING_PX 20
 
 ComponentList::ComponentList(Window* window) : IList<ComponentListRow, void*>(window, LIST_SCROLL_STYLE_SLOW, LIST_NEVER_LOOP)
@@ -7,6 +9,7 @@ ComponentList::ComponentList(Window* window) : IList<ComponentListRow, void*>(wi
 	mSelectorBarOffset = 0;
 	mCameraOffset = 0;
 	mFocused = false;
+	mLayoutDirty = false;
 }
 
 void ComponentList::addRow(const ComponentListRow& row, bool setCursorHere)
@@ -21,8 +24,8 @@ void ComponentList::addRow(const ComponentListRow& row, bool setCursorHere)
 	for(auto it = mEntries.back().data.elements.cbegin(); it != mEntries.back().data.elements.cend(); it++)
 		addChild(it->component.get());
 
-	updateElementSize(mEntries.back().data);
-	updateElementPosition(mEntries.back().data);
+	mLayoutDirty = true;
+	Window::invalidate();
 
 	if(setCursorHere)
 	{
@@ -33,13 +36,25 @@ void ComponentList::addRow(const ComponentListRow& row, bool setCursorHere)
 
 void ComponentList::onSizeChanged()
 {
+	mLayoutDirty = true;
+
+	updateCameraOffset();
+}
+
+void ComponentList::layout()
+{
+	if(!mLayoutDirty)
+		return;
+
+	mLayoutDirty = false;
+
+	float yOffset = 0;
 	for(auto it = mEntries.cbegin(); it != mEntries.cend(); it++)
 	{
 		updateElementSize(it->data);
-		updateElementPosition(it->data);
+		updateElementPosition(it->data, yOffset);
+		yOffset += getRowHeight(it->data);
 	}
-
-	updateCameraOffset();
 }
 
 void ComponentList::onFocusLost()
@@ -92,13 +107,14 @@ bool ComponentList::input(InputConfig* config, Input input)
 
 void ComponentList::update(int deltaTime)
 {
+	layout();
 	listUpdate(deltaTime);
 
 	if(size())
 	{
 		// update our currently selected row
 		for(auto it = mEntries.at(mCursor).data.elements.cbegin(); it != mEntries.at(mCursor).data.elements.cend(); it++)
-			it->component->update(deltaTime);
+			it->component->tick(deltaTime);
 	}
 }
 
@@ -160,7 +176,9 @@ void ComponentList::render(const Transform4x4f& parentTrans)
 	if(!size())
 		return;
 
-	Transform4x4f trans = parentTrans * getTransform();
+	layout();
+
+	Transform4x4f trans = getWorldTransform(parentTrans);
 
 	// clip everything to be inside our bounds
 	Vector3f dim(mSize.x(), mSize.y(), 0);
@@ -252,14 +270,8 @@ float ComponentList::getTotalRowHeight() const
 	return height;
 }
 
-void ComponentList::updateElementPosition(const ComponentListRow& row)
+void ComponentList::updateElementPosition(const ComponentListRow& row, float yOffset)
 {
-	float yOffset = 0;
-	for(auto it = mEntries.cbegin(); it != mEntries.cend() && &it->data != &row; it++)
-	{
-		yOffset += getRowHeight(it->data);
-	}
-
 	// assumes updateElementSize has already been called
 	float rowHeight = getRowHeight(row);
 
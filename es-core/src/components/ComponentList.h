@@ -43,6 +43,7 @@ struct ComponentListRow
 	}
 };
 
+// Rows are laid out once before the next update or render, not every time one is added or the size changes.
 class ComponentList : public IList<ComponentListRow, void*>
 {
 public:
@@ -60,6 +61,9 @@ public:
 	void onFocusGained() override;
 	void onFocusLost() override;
 
+	// lays out the rows now if anything changed
+	void layout();
+
 	bool moveCursor(int amt);
 	inline int getCursorId() const { return mCursor; }
 
@@ -74,9 +78,10 @@ protected:
 
 private:
 	bool mFocused;
+	bool mLayoutDirty;
 
 	void updateCameraOffset();
-	void updateElementPosition(const ComponentListRow& row);
+	void updateElementPosition(const ComponentListRow& row, float yOffset);
 	void updateElementSize(const ComponentListRow& row);
 
 	float getRowHeight(const ComponentListRow& row) const;
@@ -2,18 +2,21 @@
 
 #include "resources/Font.h"
 #include "utils/StringUtil.h"
+#include "Window.h"
 
 DateTimeEditComponent::DateTimeEditComponent(Window* window, DisplayMode dispMode) : GuiComponent(window),
 	mEditing(false), mEditIndex(0), mDisplayMode(dispMode), mRelativeUpdateAccumulator(0),
 	mColor(0x777777FF), mFont(Font::get(FONT_SIZE_SMALL, FONT_PATH_LIGHT)), mUppercase(false), mAutoSize(true)
 {
 	updateTextCache();
+	requestUpdate();
 }
 
 void DateTimeEditComponent::setDisplayMode(DisplayMode mode)
 {
 	mDisplayMode = mode;
 	updateTextCache();
+	requestUpdate();
 }
 
 bool DateTimeEditComponent::input(InputConfig* config, Input input)
@@ -131,7 +134,11 @@ void DateTimeEditComponent::update(int deltaTime)
 		{
 			mRelativeUpdateAccumulator = 0;
 			updateTextCache();
+			Window::invalidate();
 		}
+
+		// relative times keep changing
+		requestUpdate();
 	}
 
 	GuiComponent::update(deltaTime);
@@ -139,7 +146,7 @@ void DateTimeEditComponent::update(int deltaTime)
 
 void DateTimeEditComponent::render(const Transform4x4f& parentTrans)
 {
-	Transform4x4f trans = parentTrans * getTransform();
+	Transform4x4f trans = getWorldTransform(parentTrans);
 
 	if(mTextCache)
 	{
@@ -34,6 +34,7 @@ GridTileComponent::GridTileComponent(Window* window) : GuiComponent(window), mBa
 
 	setSelected(false, false);
 	setVisible(true);
+	requestUpdate();
 }
 
 void GridTileComponent::render(const Transform4x4f& parentTrans)
@@ -113,6 +114,8 @@ void GridTileComponent::applyTheme(const std::shared_ptr<ThemeData>& theme, cons
 
 	if (elem)
 		applyThemeToProperties(elem, &mSelectedProperties);
+
+	requestUpdate();
 }
 
 // Made this a static function because the ImageGridComponent need to know the default tile size
@@ -145,6 +148,7 @@ void GridTileComponent::setImage(const std::string& path)
 
 	// Resize now to prevent flickering images when scrolling
 	resize();
+	requestUpdate();
 }
 
 void GridTileComponent::setImage(const std::shared_ptr<TextureResource>& texture)
@@ -153,6 +157,7 @@ void GridTileComponent::setImage(const std::shared_ptr<TextureResource>& texture
 
 	// Resize now to prevent flickering images when scrolling
 	resize();
+	requestUpdate();
 }
 
 void GridTileComponent::setSelected(bool selected, bool allowAnimation, Vector3f* pPosition, bool force)
@@ -164,6 +169,9 @@ void GridTileComponent::setSelected(bool selected, bool allowAnimation, Vector3f
 
 	mSelected = selected;
 
+	// the colors of the new state are applied in update()
+	requestUpdate();
+
 	if (selected)
 	{
 		if (pPosition == NULL || !allowAnimation)
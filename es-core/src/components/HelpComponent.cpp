@@ -135,7 +135,7 @@ void HelpComponent::setOpacity(unsigned char opacity)
 
 void HelpComponent::render(const Transform4x4f& parentTrans)
 {
-	Transform4x4f trans = parentTrans * getTransform();
+	Transform4x4f trans = getWorldTransform(parentTrans);
 
 	if(mGrid)
 		mGrid->render(trans);
@@ -5,6 +5,7 @@
 #include "components/ImageComponent.h"
 #include "resources/Font.h"
 #include "PowerSaver.h"
+#include "Window.h"
 
 enum CursorState
 {
@@ -120,7 +121,7 @@ public:
 	inline const std::string& getSelectedName()
 	{
 		assert(size() > 0);
-		return mEntries.at(mCursor).name;
+		return getEntryName(mEntries.at(mCursor));
 	}
 
 	inline const UserData& getSelected() const
@@ -202,6 +203,11 @@ protected:
 
 		int prevCursor = mCursor;
 		scroll(mScrollVelocity);
+
+		// listUpdate() does the repeated scrolling and the title overlay fade
+		if(mScrollVelocity != 0 || mTitleOverlayOpacity != 0)
+			requestUpdate();
+
 		return (prevCursor != mCursor);
 	}
 
@@ -209,6 +215,7 @@ protected:
 	{
 		// update the title overlay opacity
 		const int dir = (mScrollTier >= mTierList.count - 1) ? 1 : -1; // fade in if scroll tier is >= 1, otherwise fade out
+		const unsigned char prevOpacity = mTitleOverlayOpacity;
 		int op = mTitleOverlayOpacity + deltaTime*dir; // we just do a 1-to-1 time -> opacity, no scaling
 		if(op >= 255)
 			mTitleOverlayOpacity = 255;
@@ -217,6 +224,12 @@ protected:
 		else
 			mTitleOverlayOpacity = (unsigned char)op;
 
+		if(mTitleOverlayOpacity != prevOpacity)
+			Window::invalidate();
+
+		if(mScrollVelocity != 0 || mTitleOverlayOpacity != 0)
+			requestUpdate();
+
 		if(mScrollVelocity == 0 || size() < 2)
 			return;
 
@@ -242,6 +255,11 @@ protected:
 		// actually perform the scrolling
 		for(int i = 0; i < scrollCount; i++)
 			scroll(mScrollVelocity);
+
+		if(scrollCount > 0)
+			Window::invalidate();
+
+		Window::scheduleUpdate(mTierList.tiers[mScrollTier].scrollDelay - mScrollCursorAccumulator);
 	}
 
 	void listRenderTitleOverlay(const Transform4x4f& /*trans*/)
@@ -307,6 +325,7 @@ protected:
 
 	virtual void onCursorChanged(const CursorState& /*state*/) {}
 	virtual void onScroll(int /*amt*/) {}
+	virtual const std::string& getEntryName(const Entry& entry) const { return entry.name; } // lists that don't keep a copy of the names override this
 };
 
 #endif // ES_CORE_COMPONENTS_ILIST_H
@@ -4,6 +4,9 @@
 #include "Log.h"
 #include "Settings.h"
 #include "ThemeData.h"
+#include "Window.h"
+
+#define FADE_IN_TIME 250 // ms for a lazily loaded image to fade in once its texture arrives
 
 Vector2i ImageComponent::getTextureSize() const
 {
@@ -21,7 +24,7 @@ Vector2f ImageComponent::getSize() const
 ImageComponent::ImageComponent(Window* window, bool forceLoad, bool dynamic) : GuiComponent(window),
 	mTargetIsMax(false), mTargetIsMin(false), mFlipX(false), mFlipY(false), mTargetSize(0, 0), mColorShift(0xFFFFFFFF),
 	mColorShiftEnd(0xFFFFFFFF), mColorGradientHorizontal(true), mForceLoad(forceLoad), mDynamic(dynamic),
-	mFadeOpacity(0), mFading(false), mRotateByTargetSize(false), mTopLeftCrop(0.0f, 0.0f), mBottomRightCrop(1.0f, 1.0f)
+	mFadeOpacity(0), mFading(false), mFadeLoaded(false), mRotateByTargetSize(false), mTopLeftCrop(0.0f, 0.0f), mBottomRightCrop(1.0f, 1.0f)
 {
 	updateColors();
 }
@@ -143,6 +146,7 @@ void ImageComponent::setImage(std::string path, bool tile)
 	}
 
 	resize();
+	Window::invalidate();
 }
 
 void ImageComponent::setImage(const char* path, size_t length, bool tile)
@@ -153,12 +157,14 @@ void ImageComponent::setImage(const char* path, size_t length, bool tile)
 	mTexture->initFromMemory(path, length);
 
 	resize();
+	Window::invalidate();
 }
 
 void ImageComponent::setImage(const std::shared_ptr<TextureResource>& texture)
 {
 	mTexture = texture;
 	resize();
+	Window::invalidate();
 }
 
 void ImageComponent::setResize(float width, float height)
@@ -322,7 +328,7 @@ void ImageComponent::render(const Transform4x4f& parentTrans)
 	if (!isVisible())
 		return;
 
-	Transform4x4f trans = parentTrans * getTransform();
+	Transform4x4f trans = getWorldTransform(parentTrans);
 	Renderer::setMatrix(trans);
 
 	if(mTexture && mOpacity > 0)
@@ -362,28 +368,43 @@ void ImageComponent::fadeIn(bool textureLoaded)
 				// Start with a zero opacity and flag it as fading
 				mFadeOpacity = 0;
 				mFading = true;
+				mFadeLoaded = false;
 				updateColors();
 			}
 		}
-		else if (mFading)
+		else if (mFading && !mFadeLoaded)
 		{
-			// The texture is loaded and we need to fade it in. The fade is based on the frame rate
-			// and is 1/4 second if running at 60 frames per second although the actual value is not
-			// that important
-			int opacity = mFadeOpacity + 255 / 15;
-			// See if we've finished fading
-			if (opacity >= 255)
-			{
-				mFadeOpacity = 255;
-				mFading = false;
-			}
-			else
-			{
-				mFadeOpacity = (unsigned char)opacity;
-			}
-			updateColors();
+			// The texture is loaded and we need to fade it in, update() takes it from here so the fade
+			// keeps going (and takes the same time) no matter if anything else is drawing frames
+			mFadeLoaded = true;
+			requestUpdate();
+		}
+	}
+}
+
+void ImageComponent::update(int deltaTime)
+{
+	if (mFading && mFadeLoaded)
+	{
+		const int opacity = mFadeOpacity + 255 * deltaTime / FADE_IN_TIME;
+
+		// See if we've finished fading
+		if (opacity >= 255)
+		{
+			mFadeOpacity = 255;
+			mFading = false;
 		}
+		else
+		{
+			mFadeOpacity = (unsigned char)opacity;
+			requestUpdate();
+		}
+
+		updateColors();
+		Window::invalidate();
 	}
+
+	GuiComponent::update(deltaTime);
 }
 
 bool ImageComponent::hasImage()
@@ -70,6 +70,7 @@ public:
 
 	bool hasImage();
 
+	void update(int deltaTime) override;
 	void render(const Transform4x4f& parentTrans) override;
 
 	virtual void applyTheme(const std::shared_ptr<ThemeData>& theme, const std::string& view, const std::string& element, unsigned int properties) override;
@@ -101,6 +102,7 @@ private:
 	std::shared_ptr<TextureResource> mTexture;
 	unsigned char			mFadeOpacity;
 	bool					mFading;
+	bool					mFadeLoaded; // the texture arrived, update() runs the fade from here
 	bool					mForceLoad;
 	bool					mDynamic;
 	bool					mRotateByTargetSize;
@@ -42,6 +42,7 @@ protected:
 	using IList<ImageGridData, T>::mCursor;
 	using IList<ImageGridData, T>::Entry;
 	using IList<ImageGridData, T>::mWindow;
+	using IList<ImageGridData, T>::requestUpdate;
 
 public:
 	using IList<ImageGridData, T>::size;
@@ -191,8 +192,16 @@ void ImageGridComponent<T>::update(int deltaTime)
 	GuiComponent::update(deltaTime);
 	listUpdate(deltaTime);
 
+	// the tiles aren't our children, their updates are passed on from here
+	bool tilesNeedUpdate = false;
 	for(auto it = mTiles.begin(); it != mTiles.end(); it++)
-		(*it)->update(deltaTime);
+	{
+		(*it)->tick(deltaTime);
+		tilesNeedUpdate |= (*it)->isUpdateNeeded();
+	}
+
+	if(tilesNeedUpdate)
+		requestUpdate();
 }
 
 template<typename T>
@@ -227,10 +236,10 @@ void ImageGridComponent<T>::render(const Transform4x4f& parentTrans)
 	{
 		std::shared_ptr<GridTileComponent> tile = (*it);
 
-		// If it's the selected image, keep it for later, otherwise render it now
+		// If it's the selected image, keep it for later, otherwise render it now unless it's scrolled out of the clip rect
 		if(tile->isSelected())
 			selectedTile = tile;
-		else
+		else if(!tile->isCulled(tileTrans))
 			tile->render(tileTrans);
 	}
 
@@ -627,6 +636,9 @@ void ImageGridComponent<T>::updateTileAtPos(int tilePos, int imgPos, bool allowA
 {
 	std::shared_ptr<GridTileComponent> tile = mTiles.at(tilePos);
 
+	// tiles apply their new state in update()
+	requestUpdate();
+
 	if(isScrollLoop())
 	{
 		if (imgPos < 0)
@@ -95,7 +95,7 @@ void NinePatchComponent::render(const Transform4x4f& parentTrans)
 	if (!isVisible())
 		return;
 
-	Transform4x4f trans = parentTrans * getTransform();
+	Transform4x4f trans = getWorldTransform(parentTrans);
 
 	if(mTexture && mVertices != NULL)
 	{
@@ -2,6 +2,7 @@
 
 #include "math/Vector2i.h"
 #include "renderers/Renderer.h"
+#include "Window.h"
 
 #define AUTO_SCROLL_RESET_DELAY 3000 // ms to reset to top after we reach the bottom
 #define AUTO_SCROLL_DELAY 1000 // ms to wait before we start to scroll
@@ -17,7 +18,7 @@ void ScrollableContainer::render(const Transform4x4f& parentTrans)
 	if (!isVisible())
 		return;
 
-	Transform4x4f trans = parentTrans * getTransform();
+	Transform4x4f trans = getWorldTransform(parentTrans);
 
 	Vector2i clipPos((int)trans.translation().x(), (int)trans.translation().y());
 
@@ -42,6 +43,7 @@ void ScrollableContainer::setAutoScroll(bool autoScroll)
 		mAutoScrollDelay = AUTO_SCROLL_DELAY;
 		mAutoScrollSpeed = AUTO_SCROLL_SPEED;
 		reset();
+		requestUpdate();
 	}else{
 		mScrollDir = Vector2f(0, 0);
 		mAutoScrollDelay = 0;
@@ -58,10 +60,13 @@ Vector2f ScrollableContainer::getScrollPos() const
 void ScrollableContainer::setScrollPos(const Vector2f& pos)
 {
 	mScrollPos = pos;
+	requestUpdate(); // to get clipped
 }
 
 void ScrollableContainer::update(int deltaTime)
 {
+	const Vector2f prevScrollPos = mScrollPos;
+
 	if(mAutoScrollSpeed != 0)
 	{
 		mAutoScrollAccumulator += deltaTime;
@@ -102,8 +107,21 @@ void ScrollableContainer::update(int deltaTime)
 		mAutoScrollResetAccumulator += deltaTime;
 		if(mAutoScrollResetAccumulator >= AUTO_SCROLL_RESET_DELAY)
 			reset();
+		else
+			Window::scheduleUpdate(AUTO_SCROLL_RESET_DELAY - mAutoScrollResetAccumulator);
+	}
+	else if(mAutoScrollSpeed != 0)
+	{
+		Window::scheduleUpdate(mAutoScrollSpeed - mAutoScrollAccumulator);
 	}
 
+	// auto scrolling never stops, it starts over from the top
+	if(mAutoScrollSpeed != 0)
+		requestUpdate();
+
+	if(mScrollPos != prevScrollPos)
+		Window::invalidate();
+
 	GuiComponent::update(deltaTime);
 }
 
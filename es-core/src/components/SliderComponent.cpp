@@ -1,6 +1,7 @@
 #include "components/SliderComponent.h"
 
 #include "resources/Font.h"
+#include "Window.h"
 
 #define MOVE_REPEAT_DELAY 500
 #define MOVE_REPEAT_RATE 40
@@ -28,6 +29,7 @@ bool SliderComponent::input(InputConfig* config, Input input)
 
 		mMoveRate = input.value ? -mSingleIncrement : 0;
 		mMoveAccumulator = -MOVE_REPEAT_DELAY;
+		requestUpdate();
 		return true;
 	}
 	if(config->isMappedLike("right", input))
@@ -37,6 +39,7 @@ bool SliderComponent::input(InputConfig* config, Input input)
 
 		mMoveRate = input.value ? mSingleIncrement : 0;
 		mMoveAccumulator = -MOVE_REPEAT_DELAY;
+		requestUpdate();
 		return true;
 	}
 
@@ -52,7 +55,11 @@ void SliderComponent::update(int deltaTime)
 		{
 			setValue(mValue + mMoveRate);
 			mMoveAccumulator -= MOVE_REPEAT_RATE;
+			Window::invalidate();
 		}
+
+		Window::scheduleUpdate(MOVE_REPEAT_RATE - mMoveAccumulator);
+		requestUpdate();
 	}
 
 	GuiComponent::update(deltaTime);
@@ -60,7 +67,7 @@ void SliderComponent::update(int deltaTime)
 
 void SliderComponent::render(const Transform4x4f& parentTrans)
 {
-	Transform4x4f trans = parentTrans * getTransform();
+	Transform4x4f trans = getWorldTransform(parentTrans);
 	Renderer::setMatrix(trans);
 
 	// render suffix
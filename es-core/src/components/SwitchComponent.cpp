@@ -28,7 +28,7 @@ bool SwitchComponent::input(InputConfig* config, Input input)
 
 void SwitchComponent::render(const Transform4x4f& parentTrans)
 {
-	Transform4x4f trans = parentTrans * getTransform();
+	Transform4x4f trans = getWorldTransform(parentTrans);
 
 	mImage.render(trans);
 
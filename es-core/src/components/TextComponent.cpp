@@ -3,11 +3,12 @@
 #include "utils/StringUtil.h"
 #include "Log.h"
 #include "Settings.h"
+#include "Window.h"
 
 TextComponent::TextComponent(Window* window) : GuiComponent(window),
 	mFont(Font::get(FONT_SIZE_MEDIUM)), mUppercase(false), mColor(0x000000FF), mAutoCalcExtent(true, true),
 	mHorizontalAlignment(ALIGN_LEFT), mVerticalAlignment(ALIGN_CENTER), mLineSpacing(1.5f), mBgColor(0),
-	mRenderBackground(false)
+	mRenderBackground(false), mWindowed(false)
 {
 }
 
@@ -15,7 +16,7 @@ TextComponent::TextComponent(Window* window, const std::string& text, const std:
 	Vector3f pos, Vector2f size, unsigned int bgcolor) : GuiComponent(window),
 	mFont(NULL), mUppercase(false), mColor(0x000000FF), mAutoCalcExtent(true, true),
 	mHorizontalAlignment(align), mVerticalAlignment(ALIGN_CENTER), mLineSpacing(1.5f), mBgColor(0),
-	mRenderBackground(false)
+	mRenderBackground(false), mWindowed(false)
 {
 	setFont(font);
 	setColor(color);
@@ -42,7 +43,6 @@ void TextComponent::setColor(unsigned int color)
 {
 	mColor = color;
 	mColorOpacity = mColor & 0x000000FF;
-	onColorChanged();
 }
 
 //  Set the color of the background box
@@ -70,8 +70,6 @@ void TextComponent::setOpacity(unsigned char opacity)
 	unsigned char bgo = (unsigned char)((float)opacity / 255.f * (float)mBgColorOpacity);
 	mBgColor = (mBgColor & 0xFFFFFF00) | (unsigned char)bgo;
 
-	onColorChanged();
-
 	GuiComponent::setOpacity(opacity);
 }
 
@@ -82,6 +80,10 @@ unsigned char TextComponent::getOpacity() const
 
 void TextComponent::setText(const std::string& text)
 {
+	// nothing to rebuild, everything else that affects the cache calls onTextChanged() itself
+	if(text == mText && (mTextCache || mWindowed))
+		return;
+
 	mText = text;
 	onTextChanged();
 }
@@ -97,7 +99,7 @@ void TextComponent::render(const Transform4x4f& parentTrans)
 	if (!isVisible())
 		return;
 
-	Transform4x4f trans = parentTrans * getTransform();
+	Transform4x4f trans = getWorldTransform(parentTrans);
 
 	if (mRenderBackground)
 	{
@@ -105,9 +107,9 @@ void TextComponent::render(const Transform4x4f& parentTrans)
 		Renderer::drawRect(0.0f, 0.0f, mSize.x(), mSize.y(), mBgColor, mBgColor);
 	}
 
-	if(mTextCache)
+	if(mTextCache || mWindowed)
 	{
-		const Vector2f& textSize = mTextCache->metrics.size;
+		const Vector2f& textSize = mWindowed ? mWindowedSize : mTextCache->metrics.size;
 		float yOff = 0;
 		switch(mVerticalAlignment)
 		{
@@ -139,38 +141,100 @@ void TextComponent::render(const Transform4x4f& parentTrans)
 			switch(mHorizontalAlignment)
 			{
 			case ALIGN_LEFT:
-				Renderer::drawRect(0.0f, 0.0f, mTextCache->metrics.size.x(), mTextCache->metrics.size.y(), 0x00000033, 0x00000033);
+				Renderer::drawRect(0.0f, 0.0f, textSize.x(), textSize.y(), 0x00000033, 0x00000033);
 				break;
 			case ALIGN_CENTER:
-				Renderer::drawRect((mSize.x() - mTextCache->metrics.size.x()) / 2.0f, 0.0f, mTextCache->metrics.size.x(), mTextCache->metrics.size.y(), 0x00000033, 0x00000033);
+				Renderer::drawRect((mSize.x() - textSize.x()) / 2.0f, 0.0f, textSize.x(), textSize.y(), 0x00000033, 0x00000033);
 				break;
 			case ALIGN_RIGHT:
-				Renderer::drawRect(mSize.x() - mTextCache->metrics.size.x(), 0.0f, mTextCache->metrics.size.x(), mTextCache->metrics.size.y(), 0x00000033, 0x00000033);
+				Renderer::drawRect(mSize.x() - textSize.x(), 0.0f, textSize.x(), textSize.y(), 0x00000033, 0x00000033);
 				break;
 			}
 		}
-		mFont->renderTextCache(mTextCache.get());
+
+		if(mWindowed)
+			renderWindowed(trans);
+		else
+			mFont->renderTextCache(mTextCache.get(), mColor);
+	}
+}
+
+void TextComponent::renderWindowed(const Transform4x4f& trans)
+{
+	const float lineHeight = mFont->getHeight(mLineSpacing);
+	const float chunkHeight = lineHeight * WINDOWED_CHUNK_LINES;
+	const size_t chunkCount = (mWindowedLayout.lines.size() + WINDOWED_CHUNK_LINES - 1) / WINDOWED_CHUNK_LINES;
+
+	// find the part of the text inside the clip rect, give up and draw everything if we're rotated
+	float top = 0.0f;
+	float bottom = mWindowedSize.y();
+	if(trans.r0().y() == 0.0f && trans.r1().x() == 0.0f && trans.r1().y() > 0.0f)
+	{
+		const Renderer::Rect clip = Renderer::getClipRect();
+		top = (clip.y - trans.translation().y()) / trans.r1().y() - lineHeight;
+		bottom = (clip.y + clip.h - trans.translation().y()) / trans.r1().y() + lineHeight;
+	}
+
+	if(bottom < 0.0f || top > mWindowedSize.y())
+	{
+		mWindowedChunks.clear();
+		return;
+	}
+
+	const size_t first = (size_t)Math::max(0.0f, top / chunkHeight);
+	const size_t last = Math::min((int)chunkCount - 1, (int)(bottom / chunkHeight));
+
+	// forget what scrolled out
+	for(auto it = mWindowedChunks.begin(); it != mWindowedChunks.end(); )
+	{
+		if(it->first < first || it->first > last)
+			it = mWindowedChunks.erase(it);
+		else
+			it++;
+	}
+
+	for(size_t i = first; i <= last; i++)
+	{
+		std::unique_ptr<TextCache>& chunk = mWindowedChunks[i];
+		if(!chunk)
+		{
+			const size_t firstLine = i * WINDOWED_CHUNK_LINES;
+			const size_t lastLine = Math::min((int)mWindowedLayout.lines.size(), (int)(firstLine + WINDOWED_CHUNK_LINES));
+
+			TextLayout layout;
+			layout.lines.assign(mWindowedLayout.lines.cbegin() + firstLine, mWindowedLayout.lines.cbegin() + lastLine);
+			layout.width = mWindowedLayout.width;
+
+			chunk.reset(mFont->buildTextCache(mWindowedText, layout, Vector2f(0.0f, firstLine * lineHeight), 0xFFFFFFFF, mSize.x(), mHorizontalAlignment, mLineSpacing));
+		}
+
+		mFont->renderTextCache(chunk.get(), mColor);
 	}
 }
 
-void TextComponent::calculateExtent()
+// only measures, the text that gets drawn may still be cut at a newline or abbreviated so no cache is built for it here
+void TextComponent::calculateExtent(const std::string& text)
 {
+	TextLayout layout;
+
 	if(mAutoCalcExtent.x())
 	{
-		mSize = mFont->sizeText(mUppercase ? Utils::String::toUpper(mText) : mText, mLineSpacing);
+		mFont->layoutText(text, 0.0f, layout);
+		mSize = mFont->sizeLayout(layout, mLineSpacing);
 	}else{
 		if(mAutoCalcExtent.y())
 		{
-			mSize[1] = mFont->sizeWrappedText(mUppercase ? Utils::String::toUpper(mText) : mText, getSize().x(), mLineSpacing).y();
+			mFont->layoutText(text, getSize().x(), layout);
+			mSize[1] = mFont->sizeLayout(layout, mLineSpacing).y();
 		}
 	}
 }
 
 void TextComponent::onTextChanged()
 {
-	calculateExtent();
+	Window::invalidate();
 
-	if(!mFont || mText.empty())
+	if(!mFont)
 	{
 		mTextCache.reset();
 		return;
@@ -178,6 +242,38 @@ void TextComponent::onTextChanged()
 
 	std::string text = mUppercase ? Utils::String::toUpper(mText) : mText;
 
+	mWindowed = false;
+	mWindowedChunks.clear();
+	mWindowedText.clear();
+	mWindowedLayout = TextLayout();
+
+	// long wrapped text is only laid out here, its vertices get built as lines become visible
+	if(!mAutoCalcExtent.x() && mSize.x() > 0 && text.size() >= WINDOWED_MIN_LENGTH && (mSize.y() == 0 || mSize.y() > mFont->getHeight()*1.2f))
+	{
+		mFont->layoutText(text, mSize.x(), mWindowedLayout);
+		if(mWindowedLayout.lines.size() >= WINDOWED_MIN_LINES)
+		{
+			mWindowed = true;
+			mWindowedText = text;
+			mWindowedSize = mFont->sizeLayout(mWindowedLayout, mLineSpacing);
+			if(mAutoCalcExtent.y())
+				mSize[1] = mWindowedSize.y();
+
+			mTextCache.reset();
+			return;
+		}
+
+		mWindowedLayout = TextLayout();
+	}
+
+	calculateExtent(text);
+
+	if(mText.empty())
+	{
+		mTextCache.reset();
+		return;
+	}
+
 	std::shared_ptr<Font> f = mFont;
 	const bool isMultiline = (mSize.y() == 0 || mSize.y() > f->getHeight()*1.2f);
 
@@ -205,17 +301,9 @@ void TextComponent::onTextChanged()
 
 		text.append(abbrev);
 
-		mTextCache = std::shared_ptr<TextCache>(f->buildTextCache(text, Vector2f(0, 0), (mColor >> 8 << 8) | mOpacity, mSize.x(), mHorizontalAlignment, mLineSpacing));
+		mTextCache = f->getTextCache(text, mSize.x(), mHorizontalAlignment, mLineSpacing);
 	}else{
-		mTextCache = std::shared_ptr<TextCache>(f->buildTextCache(f->wrapText(text, mSize.x()), Vector2f(0, 0), (mColor >> 8 << 8) | mOpacity, mSize.x(), mHorizontalAlignment, mLineSpacing));
-	}
-}
-
-void TextComponent::onColorChanged()
-{
-	if(mTextCache)
-	{
-		mTextCache->setColor(mColor);
+		mTextCache = f->getTextCache(text, mAutoCalcExtent.x() ? 0.0f : mSize.x(), mHorizontalAlignment, mLineSpacing);
 	}
 }
 
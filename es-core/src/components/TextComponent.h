@@ -4,6 +4,7 @@
 
 #include "resources/Font.h"
 #include "GuiComponent.h"
+#include <map>
 
 class ThemeData;
 
@@ -49,9 +50,20 @@ protected:
 	std::shared_ptr<Font> mFont;
 
 private:
-	void calculateExtent();
-
-	void onColorChanged();
+	void calculateExtent(const std::string& text);
+	void renderWindowed(const Transform4x4f& trans);
+
+	// Long wrapped text (game descriptions) isn't turned into one TextCache. Only its layout is kept,
+	// vertices are built a chunk of lines at a time for the lines inside the current clip rect.
+	static const size_t WINDOWED_MIN_LENGTH  = 2048; // bytes, shorter text isn't even laid out to check
+	static const size_t WINDOWED_MIN_LINES   = 32;
+	static const size_t WINDOWED_CHUNK_LINES = 8;
+
+	bool mWindowed;
+	std::string mWindowedText;
+	TextLayout mWindowedLayout;
+	Vector2f mWindowedSize;
+	std::map< size_t, std::unique_ptr<TextCache> > mWindowedChunks;
 
 	unsigned int mColor;
 	unsigned int mBgColor;
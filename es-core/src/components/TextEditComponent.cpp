@@ -2,6 +2,7 @@
 
 #include "resources/Font.h"
 #include "utils/StringUtil.h"
+#include "Window.h"
 
 #define TEXT_PADDING_HORIZ 10
 #define TEXT_PADDING_VERT 2
@@ -139,6 +140,7 @@ bool TextEditComponent::input(InputConfig* config, Input input)
 			mCursorRepeatDir = cursor_left ? -1 : 1;
 			mCursorRepeatTimer = -(CURSOR_REPEAT_START_DELAY - CURSOR_REPEAT_SPEED);
 			moveCursor(mCursorRepeatDir);
+			requestUpdate();
 		} else if(config->getDeviceId() == DEVICE_KEYBOARD)
 		{
 			switch(input.id)
@@ -185,7 +187,11 @@ void TextEditComponent::updateCursorRepeat(int deltaTime)
 	{
 		moveCursor(mCursorRepeatDir);
 		mCursorRepeatTimer -= CURSOR_REPEAT_SPEED;
+		Window::invalidate();
 	}
+
+	Window::scheduleUpdate(CURSOR_REPEAT_SPEED - mCursorRepeatTimer);
+	requestUpdate();
 }
 
 void TextEditComponent::moveCursor(int amt)
@@ -206,8 +212,9 @@ void TextEditComponent::setCursor(size_t pos)
 
 void TextEditComponent::onTextChanged()
 {
-	std::string wrappedText = (isMultiline() ? mFont->wrapText(mText, getTextAreaSize().x()) : mText);
-	mTextCache = std::unique_ptr<TextCache>(mFont->buildTextCache(wrappedText, 0, 0, 0x77777700 | getOpacity()));
+	// the layout is kept around so moving the cursor doesn't have to wrap the text again
+	mFont->layoutText(mText, isMultiline() ? getTextAreaSize().x() : 0.0f, mLayout);
+	mTextCache = std::unique_ptr<TextCache>(mFont->buildTextCache(mText, mLayout, Vector2f(0, 0), 0x77777700 | getOpacity(), 0.0f));
 
 	if(mCursor > (int)mText.length())
 		mCursor = (unsigned int)mText.length();
@@ -217,7 +224,7 @@ void TextEditComponent::onCursorChanged()
 {
 	if(isMultiline())
 	{
-		Vector2f textSize = mFont->getWrappedTextCursorOffset(mText, getTextAreaSize().x(), mCursor);
+		Vector2f textSize = mFont->getLayoutCursorOffset(mText, mLayout, mCursor);
 
 		if(mScrollOffset.y() + getTextAreaSize().y() < textSize.y() + mFont->getHeight()) //need to scroll down?
 		{
@@ -270,7 +277,7 @@ void TextEditComponent::render(const Transform4x4f& parentTrans)
 		Vector2f cursorPos;
 		if(isMultiline())
 		{
-			cursorPos = mFont->getWrappedTextCursorOffset(mText, getTextAreaSize().x(), mCursor);
+			cursorPos = mFont->getLayoutCursorOffset(mText, mLayout, mCursor);
 		}else{
 			cursorPos = mFont->sizeText(mText.substr(0, mCursor));
 			cursorPos[1] = 0;
@@ -3,11 +3,9 @@
 #define ES_CORE_COMPONENTS_TEXT_EDIT_COMPONENT_H
 
 #include "components/NinePatchComponent.h"
+#include "resources/Font.h"
 #include "GuiComponent.h"
 
-class Font;
-class TextCache;
-
 // Used to enter text.
 class TextEditComponent : public GuiComponent
 {
@@ -62,6 +60,7 @@ private:
 
 	std::shared_ptr<Font> mFont;
 	std::unique_ptr<TextCache> mTextCache;
+	TextLayout mLayout;
 };
 
 #endif // ES_CORE_COMPONENTS_TEXT_EDIT_COMPONENT_H
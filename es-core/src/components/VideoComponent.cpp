@@ -114,6 +114,9 @@ bool VideoComponent::setVideo(std::string path)
 	// Store the path
 	mVideoPath = fullPath;
 
+	// update() starts the new video
+	requestUpdate();
+
 	// If the file exists then set the new video
 	if (!fullPath.empty() && ResourceManager::getInstance()->fileExists(fullPath))
 	{
@@ -152,7 +155,7 @@ void VideoComponent::render(const Transform4x4f& parentTrans)
 	if (!isVisible())
 		return;
 
-	Transform4x4f trans = parentTrans * getTransform();
+	Transform4x4f trans = getWorldTransform(parentTrans);
 	GuiComponent::renderChildren(trans);
 
 	Renderer::setMatrix(trans);
@@ -267,6 +270,9 @@ void VideoComponent::update(int deltaTime)
 {
 	manageState();
 
+	// render() doesn't run while nothing changes on screen, a video that reached its end has to be restarted from here too
+	handleLooping();
+
 	// If the video start is delayed and there is less than the fade time then set the image fade
 	// accordingly
 	if (mStartDelayed)
@@ -278,8 +284,15 @@ void VideoComponent::update(int deltaTime)
 			if (diff < FADE_TIME_MS)
 			{
 				mFadeIn = (float)diff / (float)FADE_TIME_MS;
+				Window::invalidate();
 				return;
 			}
+			Window::scheduleUpdate(diff - FADE_TIME_MS);
+		}
+		else
+		{
+			// the delay is over, render() starts the video
+			Window::invalidate();
 		}
 	}
 	// If the fade in is less than 1 then increment it
@@ -288,6 +301,7 @@ void VideoComponent::update(int deltaTime)
 		mFadeIn += deltaTime / (float)FADE_TIME_MS;
 		if (mFadeIn > 1.0f)
 			mFadeIn = 1.0f;
+		Window::invalidate();
 	}
 	GuiComponent::update(deltaTime);
 }
@@ -325,6 +339,10 @@ void VideoComponent::manageState()
 			startVideoWithDelay();
 		}
 	}
+
+	// Playback, the start delay and the fade in all need update()
+	if (mIsPlaying || mFadeIn < 1.0f)
+		requestUpdate();
 }
 
 void VideoComponent::onShow()
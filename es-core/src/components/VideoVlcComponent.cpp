@@ -5,6 +5,7 @@
 #include "utils/StringUtil.h"
 #include "PowerSaver.h"
 #include "Settings.h"
+#include "Window.h"
 #include <vlc/vlc.h>
 #include <SDL_mutex.h>
 
@@ -32,7 +33,8 @@ static void unlock(void *data, void* /*id*/, void *const* /*p_pixels*/) {
 
 // VLC wants to display a video frame.
 static void display(void* /*data*/, void* /*id*/) {
-	//Data to be displayed
+	// called from a VLC thread, the new frame gets uploaded by the next render
+	Window::wake();
 }
 
 VideoVlcComponent::VideoVlcComponent(Window* window, std::string subtitles) :
@@ -135,7 +137,7 @@ void VideoVlcComponent::render(const Transform4x4f& parentTrans)
 		return;
 
 	VideoComponent::render(parentTrans);
-	Transform4x4f trans = parentTrans * getTransform();
+	Transform4x4f trans = getWorldTransform(parentTrans);
 	GuiComponent::renderChildren(trans);
 	Renderer::setMatrix(trans);
 
@@ -243,6 +243,9 @@ void GuiInputConfig::update(int deltaTime)
 		mHeldTime += deltaTime;
 		int curSec = mHeldTime / 1000;
 
+		// the countdown text changes every second
+		Window::scheduleUpdate(1000 - mHeldTime % 1000);
+
 		if(mHeldTime >= HOLD_TO_SKIP_MS)
 		{
 			setNotDefined(mMappings.at(mHeldInputId));
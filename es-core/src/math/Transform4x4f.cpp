@@ -1,10 +1,62 @@
 #include "math/Transform4x4f.h"
 
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#endif
+
+// multiply, transform and translate work on whole columns when SSE2 or NEON are available
+// mul and add stay separate (no fused multiply-add) and in the same order as the scalar code, so the results are identical
+#if defined(__SSE2__)
+#define MATH_SIMD
+typedef __m128 float4;
+static inline float4 load4 (const float* _f)                { return _mm_loadu_ps(_f); }
+static inline void   store4(float* _f, const float4 _v)     { _mm_storeu_ps(_f, _v); }
+static inline float4 splat4(const float _f)                 { return _mm_set1_ps(_f); }
+static inline float4 add4  (const float4 _a, const float4 _b) { return _mm_add_ps(_a, _b); }
+static inline float4 mul4  (const float4 _a, const float4 _b) { return _mm_mul_ps(_a, _b); }
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define MATH_SIMD
+typedef float32x4_t float4;
+static inline float4 load4 (const float* _f)                { return vld1q_f32(_f); }
+static inline void   store4(float* _f, const float4 _v)     { vst1q_f32(_f, _v); }
+static inline float4 splat4(const float _f)                 { return vdupq_n_f32(_f); }
+static inline float4 add4  (const float4 _a, const float4 _b) { return vaddq_f32(_a, _b); }
+static inline float4 mul4  (const float4 _a, const float4 _b) { return vmulq_f32(_a, _b); }
+#endif
+
 const Transform4x4f Transform4x4f::operator*(const Transform4x4f& _other) const
 {
 	const float* tm = (float*)this;
 	const float* om = (float*)&_other;
 
+#if defined(MATH_SIMD)
+	const float4  c0 = load4(&tm[ 0]);
+	const float4  c1 = load4(&tm[ 4]);
+	const float4  c2 = load4(&tm[ 8]);
+	Transform4x4f result;
+	float*        rm = (float*)&result;
+
+	for(int i = 0; i < 4; ++i)
+	{
+		const float* oc  = &om[i * 4];
+		float4       col = add4(add4(mul4(c0, splat4(oc[0])), mul4(c1, splat4(oc[1]))), mul4(c2, splat4(oc[2])));
+
+		if(i == 3)
+			col = add4(col, load4(&tm[12]));
+
+		store4(&rm[i * 4], col);
+	}
+
+	// like the scalar version this only handles affine transforms
+	rm[ 3] = 0;
+	rm[ 7] = 0;
+	rm[11] = 0;
+	rm[15] = 1;
+
+	return result;
+#else
 	return
 	{
 		{
@@ -32,6 +84,7 @@ const Transform4x4f Transform4x4f::operator*(const Transform4x4f& _other) const
 			1
 		}
 	};
+#endif // MATH_SIMD
 
 } // operator*
 
@@ -40,12 +93,19 @@ const Vector3f Transform4x4f::operator*(const Vector3f& _other) const
 	const float* tm = (float*)this;
 	const float* ov = (float*)&_other;
 
+#if defined(MATH_SIMD)
+	float out[4];
+	store4(out, add4(add4(add4(mul4(load4(&tm[0]), splat4(ov[0])), mul4(load4(&tm[4]), splat4(ov[1]))), mul4(load4(&tm[8]), splat4(ov[2]))), load4(&tm[12])));
+
+	return { out[0], out[1], out[2] };
+#else
 	return
 	{
 		tm[ 0] * ov[0] + tm[ 4] * ov[1] + tm[ 8] * ov[2] + tm[12],
 		tm[ 1] * ov[0] + tm[ 5] * ov[1] + tm[ 9] * ov[2] + tm[13],
 		tm[ 2] * ov[0] + tm[ 6] * ov[1] + tm[10] * ov[2] + tm[14]
 	};
+#endif // MATH_SIMD
 
 } // operator*
 
@@ -296,9 +356,19 @@ Transform4x4f& Transform4x4f::translate(const Vector3f& _translation)
 	float*       tm = (float*)this;
 	const float* tv = (float*)&_translation;
 
+#if defined(MATH_SIMD)
+	float out[4];
+	store4(out, add4(load4(&tm[12]), add4(add4(mul4(load4(&tm[0]), splat4(tv[0])), mul4(load4(&tm[4]), splat4(tv[1]))), mul4(load4(&tm[8]), splat4(tv[2])))));
+
+	// w stays as it is
+	tm[12] = out[0];
+	tm[13] = out[1];
+	tm[14] = out[2];
+#else
 	tm[12] += tm[ 0] * tv[0] + tm[ 4] * tv[1] + tm[ 8] * tv[2];
 	tm[13] += tm[ 1] * tv[0] + tm[ 5] * tv[1] + tm[ 9] * tv[2];
 	tm[14] += tm[ 2] * tv[0] + tm[ 6] * tv[1] + tm[10] * tv[2];
+#endif // MATH_SIMD
 
 	return *this;
 
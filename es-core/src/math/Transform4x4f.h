@@ -15,6 +15,8 @@ public:
 	const Transform4x4f operator* (const Transform4x4f& _other) const;
 	const Vector3f      operator* (const Vector3f& _other) const;
 	Transform4x4f&      operator*=(const Transform4x4f& _other) { *this = *this * _other; return *this; }
+	const bool          operator==(const Transform4x4f& _other) const { return ((mR0 == _other.mR0) && (mR1 == _other.mR1) && (mR2 == _other.mR2) && (mR3 == _other.mR3)); }
+	const bool          operator!=(const Transform4x4f& _other) const { return ((mR0 != _other.mR0) || (mR1 != _other.mR1) || (mR2 != _other.mR2) || (mR3 != _other.mR3)); }
 
 	inline       Vector4f& r0()       { return mR0; }
 	inline       Vector4f& r1()       { return mR1; }
@@ -1,5 +1,6 @@
 #include "renderers/Renderer.h"
 
+#include "math/Misc.h"
 #include "math/Transform4x4f.h"
 #include "math/Vector2i.h"
 #include "resources/ResourceManager.h"
@@ -8,11 +9,67 @@
 #include "Settings.h"
 
 #include <SDL.h>
+#include <atomic>
+#include <condition_variable>
+#include <map>
+#include <mutex>
 #include <stack>
+#include <stdio.h>
+#include <thread>
+#include <vector>
 
 namespace Renderer
 {
+	namespace CommandType
+	{
+		enum Type
+		{
+			CREATE_TEXTURE       = 0,
+			DESTROY_TEXTURE      = 1,
+			UPDATE_TEXTURE       = 2,
+			DRAW_LINES           = 3,
+			DRAW_TRIANGLE_STRIPS = 4,
+			SET_SCISSOR          = 5,
+			SWAP_BUFFERS         = 6,
+			COPY_TO_TEXTURE      = 7
+
+		}; // Type
+
+	} // CommandType::
+
+	// a backend call recorded for the render thread
+	struct Command
+	{
+		Command(const CommandType::Type _type) : type(_type), texture(0), textureType(Texture::RGBA), linear(false), repeat(false), hasData(false),
+		                                         x(0), y(0), w(0), h(0), offset(0), numVertices(0), srcBlend(Blend::SRC_ALPHA), dstBlend(Blend::ONE_MINUS_SRC_ALPHA) { }
+
+		CommandType::Type type;
+		unsigned int      texture;
+		Texture::Type     textureType;
+		bool              linear;
+		bool              repeat;
+		bool              hasData;
+		int               x;           // texture area or scissor
+		int               y;
+		int               w;
+		int               h;
+		size_t            offset;      // into CommandList::vertices for draws, into CommandList::data for textures
+		unsigned int      numVertices;
+		Blend::Factor     srcBlend;
+		Blend::Factor     dstBlend;
+
+	}; // Command
+
+	struct CommandList
+	{
+		std::vector<Command>       commands;
+		std::vector<Vertex>        vertices;
+		std::vector<unsigned char> data;
+
+	}; // CommandList
+
 	static std::stack<Rect> clipStack;
+	static std::stack<Rect> screenClipStack; // clipStack before rotation and screen offset, for getClipRect()
 	static SDL_Window*      sdlWindow          = nullptr;
 	static int              windowWidth        = 0;
 	static int              windowHeight       = 0;
@@ -23,6 +80,258 @@ namespace Renderer
 	static int              screenRotate       = 0;
 	static bool             initialCursorState = 1;
 
+	// the batch waiting to be drawn, see flushBatch()
+	static std::vector<Vertex> batchVertices;
+	static unsigned int        batchTexture       = 0;
+	static Blend::Factor       batchSrcBlend      = Blend::SRC_ALPHA;
+	static Blend::Factor       batchDstBlend      = Blend::ONE_MINUS_SRC_ALPHA;
+	static unsigned int        boundTexture       = 0;
+	static Transform4x4f       currentMatrix      = Transform4x4f::Identity();
+	static FrameStats          frameStats;
+	static FrameStats          lastFrameStats;
+	static std::atomic<unsigned int> texturesDecoded(0);
+	static FILE*               statsFile          = nullptr; // FrameStatsFile, stays open across reinits
+	static unsigned int        statsFrame         = 0;
+	static unsigned int        statsLastTicks     = 0;
+	static std::atomic<unsigned int> stateChanges(0);        // counted by whichever thread talks to the backend
+	static std::atomic<unsigned int> skippedStateChanges(0);
+
+	// ThreadedRendering, the main thread records into one list while the render thread submits the other
+	static bool                    threaded         = false; // only changes in init() and deinit()
+	static std::thread*            renderThread     = nullptr;
+	static std::mutex              renderMutex;
+	static std::condition_variable renderEvent;
+	static bool                    renderExit       = false;
+	static CommandList             commandLists[2];
+	static CommandList*            recordingList    = &commandLists[0];
+	static CommandList*            submittingList   = nullptr; // the list the render thread works on, nullptr when it's idle
+	static unsigned int            nextTexture      = 1;       // the renderer's texture ids, 0 stays "no texture"
+	static std::map<unsigned int, unsigned int> backendTextures; // render thread only, the renderer's texture ids to the backend's
+
+	static Command& record(const CommandType::Type _type)
+	{
+		recordingList->commands.push_back(Command(_type));
+		return recordingList->commands.back();
+
+	} // record
+
+	static size_t recordData(const void* _data, const size_t _size)
+	{
+		const size_t offset = recordingList->data.size();
+		recordingList->data.insert(recordingList->data.end(), (const unsigned char*)_data, (const unsigned char*)_data + _size);
+		return offset;
+
+	} // recordData
+
+	static unsigned int getBackendTexture(const unsigned int _texture)
+	{
+		auto it = backendTextures.find(_texture);
+		return (it != backendTextures.cend()) ? it->second : 0;
+
+	} // getBackendTexture
+
+	static void executeCommands(CommandList& _list)
+	{
+		for(auto it = _list.commands.cbegin(); it != _list.commands.cend(); ++it)
+		{
+			const Command& command = *it;
+			void*          data    = command.hasData ? &_list.data[command.offset] : nullptr;
+
+			switch(command.type)
+			{
+				case CommandType::CREATE_TEXTURE:       { backendTextures[command.texture] = Backend::createTexture(command.textureType, command.linear, command.repeat, command.w, command.h, data); } break;
+				case CommandType::DESTROY_TEXTURE:      { Backend::destroyTexture(getBackendTexture(command.texture)); backendTextures.erase(command.texture);                                       } break;
+				case CommandType::UPDATE_TEXTURE:       { Backend::updateTexture(getBackendTexture(command.texture), command.textureType, command.x, command.y, command.w, command.h, data);          } break;
+				case CommandType::DRAW_LINES:           { Backend::bindTexture(getBackendTexture(command.texture)); Backend::drawLines(&_list.vertices[command.offset], command.numVertices, command.srcBlend, command.dstBlend);          } break;
+				case CommandType::DRAW_TRIANGLE_STRIPS: { Backend::bindTexture(getBackendTexture(command.texture)); Backend::drawTriangleStrips(&_list.vertices[command.offset], command.numVertices, command.srcBlend, command.dstBlend); } break;
+				case CommandType::SET_SCISSOR:          { Backend::setScissor(Rect(command.x, command.y, command.w, command.h));                                                                    } break;
+				case CommandType::SWAP_BUFFERS:         { Backend::swapBuffers();                                                                                                                   } break;
+				case CommandType::COPY_TO_TEXTURE:      { Backend::copyToTexture(getBackendTexture(command.texture), Rect(command.x, command.y, command.w, command.h));                               } break;
+			}
+		}
+
+		_list.commands.clear();
+		_list.vertices.clear();
+		_list.data.clear();
+
+	} // executeCommands
+
+	static void renderThreadProc()
+	{
+		setContextCurrent(true);
+
+		std::unique_lock<std::mutex> lock(renderMutex);
+
+		while(true)
+		{
+			while((submittingList == nullptr) && !renderExit)
+				renderEvent.wait(lock);
+
+			// whatever was handed over before the exit still gets submitted
+			if(submittingList == nullptr)
+				break;
+
+			lock.unlock();
+			executeCommands(*submittingList);
+			lock.lock();
+
+			submittingList = nullptr;
+			renderEvent.notify_all();
+		}
+
+		// anything left belongs to a context that is about to go away
+		backendTextures.clear();
+
+		setContextCurrent(false);
+
+	} // renderThreadProc
+
+	static void submitCommands()
+	{
+		std::unique_lock<std::mutex> lock(renderMutex);
+
+		// the previous frame has to be submitted before its list can be recorded into again
+		while(submittingList != nullptr)
+			renderEvent.wait(lock);
+
+		submittingList = recordingList;
+		recordingList  = (recordingList == &commandLists[0]) ? &commandLists[1] : &commandLists[0];
+		renderEvent.notify_all();
+
+	} // submitCommands
+
+	static void startRenderThread()
+	{
+		// the context can only be current on one thread
+		setContextCurrent(false);
+
+		renderExit   = false;
+		renderThread = new std::thread(renderThreadProc);
+		threaded     = true;
+
+	} // startRenderThread
+
+	static void stopRenderThread()
+	{
+		// textures destroyed after the last frame still have to reach the backend
+		submitCommands();
+
+		{
+			std::unique_lock<std::mutex> lock(renderMutex);
+			renderExit = true;
+			renderEvent.notify_all();
+		}
+
+		renderThread->join();
+		delete renderThread;
+		renderThread = nullptr;
+		threaded     = false;
+
+		setContextCurrent(true);
+
+	} // stopRenderThread
+
+	static void backendDraw(const CommandType::Type _type, const unsigned int _texture, const Vertex* _vertices, const unsigned int _numVertices, const Blend::Factor _srcBlendFactor, const Blend::Factor _dstBlendFactor)
+	{
+		if(threaded)
+		{
+			Command& command = record(_type);
+			command.texture     = _texture;
+			command.offset      = recordingList->vertices.size();
+			command.numVertices = _numVertices;
+			command.srcBlend    = _srcBlendFactor;
+			command.dstBlend    = _dstBlendFactor;
+
+			recordingList->vertices.insert(recordingList->vertices.end(), _vertices, _vertices + _numVertices);
+			return;
+		}
+
+		Backend::bindTexture(_texture);
+
+		if(_type == CommandType::DRAW_LINES) Backend::drawLines(_vertices, _numVertices, _srcBlendFactor, _dstBlendFactor);
+		else                                 Backend::drawTriangleStrips(_vertices, _numVertices, _srcBlendFactor, _dstBlendFactor);
+
+	} // backendDraw
+
+	static void backendSetScissor(const Rect& _scissor)
+	{
+		if(threaded)
+		{
+			Command& command = record(CommandType::SET_SCISSOR);
+			command.x = _scissor.x;
+			command.y = _scissor.y;
+			command.w = _scissor.w;
+			command.h = _scissor.h;
+			return;
+		}
+
+		Backend::setScissor(_scissor);
+
+	} // backendSetScissor
+
+	static void flushBatch()
+	{
+		if(batchVertices.empty())
+			return;
+
+		// createTexture() and updateTexture() may have bound something else in the meantime
+		backendDraw(CommandType::DRAW_TRIANGLE_STRIPS, batchTexture, batchVertices.data(), (unsigned int)batchVertices.size(), batchSrcBlend, batchDstBlend);
+		batchVertices.clear();
+
+		frameStats.batches++;
+		frameStats.textureBinds++;
+
+	} // flushBatch
+
+	static inline Vertex transformVertex(const Vertex& _vertex)
+	{
+		// only what a 2D position needs of currentMatrix * Vector3f(pos, 0)
+		const float* tm = (const float*)&currentMatrix;
+		Vertex       vertex = _vertex;
+
+		vertex.pos = Vector2f((tm[0] * _vertex.pos.x()) + (tm[4] * _vertex.pos.y()) + tm[12],
+		                      (tm[1] * _vertex.pos.x()) + (tm[5] * _vertex.pos.y()) + tm[13]);
+
+		return vertex;
+
+	} // transformVertex
+
+	static size_t textureSize(const Texture::Type _type, const unsigned int _width, const unsigned int _height)
+	{
+		return (size_t)_width * _height * ((_type == Texture::ALPHA) ? 1 : 4);
+
+	} // textureSize
+
+	static void openStatsFile()
+	{
+		const std::string& path = Settings::getInstance()->getString("FrameStatsFile");
+		if(statsFile || path.empty())
+			return;
+
+		if((statsFile = fopen(path.c_str(), "w")) == nullptr)
+		{
+			LOG(LogError) << "Could not open frame stats file " << path;
+			return;
+		}
+
+		fprintf(statsFile, "frame,ticks,frame_ms,draw_calls,batches,vertices,texture_binds,state_changes,skipped_state_changes,uploads,upload_bytes,clip_pushes,text_caches_built,textures_decoded,transforms_built,transforms_multiplied,transforms_reused,components_drawn,components_culled\n");
+
+	} // openStatsFile
+
+	static void writeStats(const FrameStats& _stats)
+	{
+		const unsigned int ticks = SDL_GetTicks();
+
+		fprintf(statsFile, "%u,%u,%u,%u,%u,%u,%u,%u,%u,%u,%u,%u,%u,%u,%u,%u,%u,%u,%u\n", statsFrame, ticks, statsLastTicks ? (ticks - statsLastTicks) : 0,
+		        _stats.drawCalls, _stats.batches, _stats.vertices, _stats.textureBinds, _stats.stateChanges, _stats.skippedStateChanges,
+		        _stats.uploads, (unsigned int)_stats.uploadBytes, _stats.clipPushes, _stats.textCachesBuilt, _stats.texturesDecoded,
+		        _stats.transformsBuilt, _stats.transformsMultiplied, _stats.transformsReused, _stats.componentsDrawn, _stats.componentsCulled);
+
+		statsFrame++;
+		statsLastTicks = ticks;
+
+	} // writeStats
+
 	static void setIcon()
 	{
 		size_t                     width   = 0;
@@ -117,6 +426,8 @@ namespace Renderer
 		if(!createWindow())
 			return false;
 
+		openStatsFile();
+
 		Transform4x4f projection = Transform4x4f::Identity();
 		Rect          viewport   = Rect(0, 0, 0, 0);
 
@@ -173,8 +484,13 @@ namespace Renderer
 			break;
 		}
 
-		setViewport(viewport);
-		setProjection(projection);
+		Backend::setViewport(viewport);
+		Backend::setProjection(projection);
+		Backend::setMatrix(Transform4x4f::Identity()); // everything is transformed on the CPU
+
+		if(Settings::getInstance()->getBool("ThreadedRendering"))
+			startRenderThread();
+
 		swapBuffers();
 
 		return true;
@@ -183,8 +499,16 @@ namespace Renderer
 
 	void deinit()
 	{
+		batchVertices.clear();
+
+		if(threaded)
+			stopRenderThread();
+
 		destroyWindow();
 
+		if(statsFile)
+			fflush(statsFile);
+
 	} // deinit
 
 	void pushClipRect(const Vector2i& _pos, const Vector2i& _size)
@@ -194,6 +518,19 @@ namespace Renderer
 		if(box.w == 0) box.w = screenWidth  - box.x;
 		if(box.h == 0) box.h = screenHeight - box.y;
 
+		Rect screenBox = box;
+		if(screenClipStack.size())
+		{
+			const Rect& top = screenClipStack.top();
+			const int   x2  = Math::min(top.x + top.w, screenBox.x + screenBox.w);
+			const int   y2  = Math::min(top.y + top.h, screenBox.y + screenBox.h);
+			screenBox.x = Math::max(top.x, screenBox.x);
+			screenBox.y = Math::max(top.y, screenBox.y);
+			screenBox.w = Math::max(0, x2 - screenBox.x);
+			screenBox.h = Math::max(0, y2 - screenBox.y);
+		}
+		screenClipStack.push(screenBox);
+
 		switch(screenRotate)
 		{
 			case 0: { box = Rect(screenOffsetX + box.x,                       screenOffsetY + box.y,                        box.w, box.h); } break;
@@ -216,8 +553,10 @@ namespace Renderer
 		if(box.h < 0) box.h = 0;
 
 		clipStack.push(box);
+		frameStats.clipPushes++;
 
-		setScissor(box);
+		flushBatch();
+		backendSetScissor(box);
 
 	} // pushClipRect
 
@@ -230,12 +569,24 @@ namespace Renderer
 		}
 
 		clipStack.pop();
+		screenClipStack.pop();
+
+		flushBatch();
 
-		if(clipStack.empty()) setScissor(Rect(0, 0, 0, 0));
-		else                  setScissor(clipStack.top());
+		if(clipStack.empty()) backendSetScissor(Rect(0, 0, 0, 0));
+		else                  backendSetScissor(clipStack.top());
 
 	} // popClipRect
 
+	Rect getClipRect()
+	{
+		if(screenClipStack.empty())
+			return Rect(0, 0, screenWidth, screenHeight);
+
+		return screenClipStack.top();
+
+	} // getClipRect
+
 	void drawRect(const float _x, const float _y, const float _w, const float _h, const unsigned int _color, const unsigned int _colorEnd, bool horizontalGradient, const Blend::Factor _srcBlendFactor, const Blend::Factor _dstBlendFactor)
 	{
 		const unsigned int color    = convertColor(_color);
@@ -256,6 +607,267 @@ namespace Renderer
 
 	} // drawRect
 
+	unsigned int createTexture(const Texture::Type _type, const bool _linear, const bool _repeat, const unsigned int _width, const unsigned int _height, void* _data)
+	{
+		if(_data != nullptr)
+		{
+			frameStats.uploads++;
+			frameStats.uploadBytes += textureSize(_type, _width, _height);
+		}
+
+		if(threaded)
+		{
+			Command& command = record(CommandType::CREATE_TEXTURE);
+			command.texture     = nextTexture++;
+			command.textureType = _type;
+			command.linear      = _linear;
+			command.repeat      = _repeat;
+			command.w           = _width;
+			command.h           = _height;
+
+			if(_data != nullptr)
+			{
+				command.hasData = true;
+				command.offset  = recordData(_data, textureSize(_type, _width, _height));
+			}
+
+			return command.texture;
+		}
+
+		return Backend::createTexture(_type, _linear, _repeat, _width, _height, _data);
+
+	} // createTexture
+
+	void destroyTexture(const unsigned int _texture)
+	{
+		// the id could be reused for a new texture before the batch is drawn
+		if(_texture == batchTexture)
+			flushBatch();
+
+		if(_texture == boundTexture)
+			boundTexture = 0;
+
+		if(threaded)
+		{
+			record(CommandType::DESTROY_TEXTURE).texture = _texture;
+			return;
+		}
+
+		Backend::destroyTexture(_texture);
+
+	} // destroyTexture
+
+	void updateTexture(const unsigned int _texture, const Texture::Type _type, const unsigned int _x, const unsigned _y, const unsigned int _width, const unsigned int _height, void* _data)
+	{
+		// what was drawn before the update has to use the old contents
+		if(_texture == batchTexture)
+			flushBatch();
+
+		if(threaded)
+		{
+			Command& command = record(CommandType::UPDATE_TEXTURE);
+			command.texture     = _texture;
+			command.textureType = _type;
+			command.x           = _x;
+			command.y           = _y;
+			command.w           = _width;
+			command.h           = _height;
+
+			if(_data != nullptr)
+			{
+				command.hasData = true;
+				command.offset  = recordData(_data, textureSize(_type, _width, _height));
+			}
+		}
+		else
+			Backend::updateTexture(_texture, _type, _x, _y, _width, _height, _data);
+
+		frameStats.uploads++;
+		frameStats.uploadBytes += textureSize(_type, _width, _height);
+
+	} // updateTexture
+
+	void bindTexture(const unsigned int _texture)
+	{
+		// takes effect with the next draw
+		boundTexture = _texture;
+
+	} // bindTexture
+
+	bool canCopyToTexture()
+	{
+		return screenRotate == 0;
+
+	} // canCopyToTexture
+
+	void copyToTexture(const unsigned int _texture, const int _x, const int _y, const int _width, const int _height)
+	{
+		// everything drawn so far has to be in the copy
+		flushBatch();
+
+		const Rect area(screenOffsetX + _x, screenOffsetY + _y, _width, _height);
+
+		if(threaded)
+		{
+			Command& command = record(CommandType::COPY_TO_TEXTURE);
+			command.texture = _texture;
+			command.x       = area.x;
+			command.y       = area.y;
+			command.w       = area.w;
+			command.h       = area.h;
+			return;
+		}
+
+		Backend::copyToTexture(_texture, area);
+
+	} // copyToTexture
+
+	void drawLines(const Vertex* _vertices, const unsigned int _numVertices, const Blend::Factor _srcBlendFactor, const Blend::Factor _dstBlendFactor)
+	{
+		// lines are only used for debugging, they don't get batched
+		flushBatch();
+
+		std::vector<Vertex> vertices(_numVertices);
+		for(unsigned int i = 0; i < _numVertices; ++i)
+			vertices[i] = transformVertex(_vertices[i]);
+
+		backendDraw(CommandType::DRAW_LINES, boundTexture, vertices.data(), _numVertices, _srcBlendFactor, _dstBlendFactor);
+
+		frameStats.drawCalls++;
+		frameStats.batches++;
+		frameStats.vertices += _numVertices;
+		frameStats.textureBinds++;
+
+	} // drawLines
+
+	static void batchTriangleStrips(const Vertex* _vertices, const unsigned int _numVertices, const unsigned int* _color, const Blend::Factor _srcBlendFactor, const Blend::Factor _dstBlendFactor)
+	{
+		if(_numVertices < 3)
+			return;
+
+		frameStats.drawCalls++;
+		frameStats.vertices += _numVertices;
+
+		if((boundTexture != batchTexture) || (_srcBlendFactor != batchSrcBlend) || (_dstBlendFactor != batchDstBlend))
+		{
+			flushBatch();
+
+			batchTexture  = boundTexture;
+			batchSrcBlend = _srcBlendFactor;
+			batchDstBlend = _dstBlendFactor;
+		}
+
+		const size_t first = batchVertices.size();
+
+		// join strips with two degenerate triangles, repeating the last vertex of the batch and the first one of the new strip
+		if(!batchVertices.empty())
+		{
+			const Vertex last = batchVertices.back();
+			batchVertices.push_back(last);
+			batchVertices.push_back(transformVertex(_vertices[0]));
+		}
+
+		for(unsigned int i = 0; i < _numVertices; ++i)
+			batchVertices.push_back(transformVertex(_vertices[i]));
+
+		// the vertices are copied anyway, a tint costs nothing more than writing the color along
+		if(_color)
+		{
+			for(size_t i = first + (first ? 1 : 0); i < batchVertices.size(); ++i)
+				batchVertices[i].col = *_color;
+		}
+
+	} // batchTriangleStrips
+
+	void drawTriangleStrips(const Vertex* _vertices, const unsigned int _numVertices, const Blend::Factor _srcBlendFactor, const Blend::Factor _dstBlendFactor)
+	{
+		batchTriangleStrips(_vertices, _numVertices, nullptr, _srcBlendFactor, _dstBlendFactor);
+
+	} // drawTriangleStrips
+
+	void drawTintedTriangleStrips(const Vertex* _vertices, const unsigned int _numVertices, const unsigned int _color, const Blend::Factor _srcBlendFactor, const Blend::Factor _dstBlendFactor)
+	{
+		const unsigned int color = convertColor(_color);
+		batchTriangleStrips(_vertices, _numVertices, &color, _srcBlendFactor, _dstBlendFactor);
+
+	} // drawTintedTriangleStrips
+
+	void setMatrix(const Transform4x4f& _matrix)
+	{
+		currentMatrix = _matrix;
+		currentMatrix.round();
+
+	} // setMatrix
+
+	void swapBuffers()
+	{
+		flushBatch();
+
+		if(threaded)
+		{
+			// only waits if the render thread is still busy with the previous frame
+			record(CommandType::SWAP_BUFFERS);
+			submitCommands();
+		}
+		else
+			Backend::swapBuffers();
+
+		// with ThreadedRendering the state changes are the ones of the frames submitted in the meantime
+		frameStats.texturesDecoded     = texturesDecoded.exchange(0);
+		frameStats.stateChanges        = stateChanges.exchange(0);
+		frameStats.skippedStateChanges = skippedStateChanges.exchange(0);
+
+		if(statsFile)
+			writeStats(frameStats);
+
+		lastFrameStats = frameStats;
+		frameStats     = FrameStats();
+
+	} // swapBuffers
+
+	const FrameStats& getFrameStats()
+	{
+		return lastFrameStats;
+
+	} // getFrameStats
+
+	void countStateChange(const bool _skipped)
+	{
+		if(_skipped) skippedStateChanges++;
+		else         stateChanges++;
+
+	} // countStateChange
+
+	void countTextCacheBuilt()
+	{
+		frameStats.textCachesBuilt++;
+
+	} // countTextCacheBuilt
+
+	void countTransform(const TransformOp::Type _op)
+	{
+		switch(_op)
+		{
+			case TransformOp::BUILT:      { frameStats.transformsBuilt++;      } break;
+			case TransformOp::MULTIPLIED: { frameStats.transformsMultiplied++; } break;
+			case TransformOp::REUSED:     { frameStats.transformsReused++;     } break;
+		}
+
+	} // countTransform
+
+	void countComponent(const bool _culled)
+	{
+		if(_culled) frameStats.componentsCulled++;
+		else        frameStats.componentsDrawn++;
+
+	} // countComponent
+
+	void countTextureDecoded()
+	{
+		texturesDecoded++;
+
+	} // countTextureDecoded
+
 	SDL_Window* getSDLWindow()     { return sdlWindow; }
 	int         getWindowWidth()   { return windowWidth; }
 	int         getWindowHeight()  { return windowHeight; }
@@ -40,6 +40,18 @@ namespace Renderer
 
 	} // Texture::
 
+	namespace TransformOp
+	{
+		enum Type
+		{
+			BUILT      = 0, // a component's local transform was rebuilt
+			MULTIPLIED = 1, // a component's world transform was rebuilt from its parent's
+			REUSED     = 2  // either one came from the cache
+
+		}; // Type
+
+	} // TransformOp::
+
 	struct Rect
 	{
 		Rect(const int _x, const int _y, const int _w, const int _h) : x(_x), y(_y), w(_w), h(_h) { }
@@ -62,12 +74,62 @@ namespace Renderer
 
 	}; // Vertex
 
+	struct FrameStats
+	{
+		FrameStats() : drawCalls(0), batches(0), vertices(0), textureBinds(0), stateChanges(0), skippedStateChanges(0),
+		               uploads(0), uploadBytes(0), clipPushes(0), textCachesBuilt(0), texturesDecoded(0),
+		               transformsBuilt(0), transformsMultiplied(0), transformsReused(0), componentsDrawn(0), componentsCulled(0) { }
+
+		unsigned int drawCalls;           // draws requested by components
+		unsigned int batches;             // draws that reached the backend
+		unsigned int vertices;            // requested by components
+		unsigned int textureBinds;        // textures bound for the backend's draws
+		unsigned int stateChanges;        // state changes the backend passed on to the graphics API
+		unsigned int skippedStateChanges; // state changes the backend skipped because nothing changed
+		unsigned int uploads;             // texture creations with data and texture updates
+		size_t       uploadBytes;
+		unsigned int clipPushes;
+		unsigned int textCachesBuilt;
+		unsigned int texturesDecoded;     // images and SVGs, including the ones decoded by the texture loader thread
+		unsigned int transformsBuilt;     // see TransformOp
+		unsigned int transformsMultiplied;
+		unsigned int transformsReused;
+		unsigned int componentsDrawn;     // components that passed GuiComponent::isCulled()
+		unsigned int componentsCulled;    // components skipped with everything below them
+
+	}; // FrameStats
+
 	bool        init            ();
 	void        deinit          ();
 	void        pushClipRect    (const Vector2i& _pos, const Vector2i& _size);
 	void        popClipRect     ();
+	Rect        getClipRect     (); // in screen coordinates, the whole screen when nothing is clipped
 	void        drawRect        (const float _x, const float _y, const float _w, const float _h, const unsigned int _color, const unsigned int _colorEnd, bool horizontalGradient = false, const Blend::Factor _srcBlendFactor = Blend::SRC_ALPHA, const Blend::Factor _dstBlendFactor = Blend::ONE_MINUS_SRC_ALPHA);
 
+	// draws are batched, vertices are transformed on the CPU and consecutive triangle strips with the same texture
+	// and blending go to the backend as one draw, the batch is flushed when the state changes, on clipping and on swapBuffers()
+	// with ThreadedRendering the backend calls of a frame are recorded instead, swapBuffers() hands them to a render thread that owns
+	// the context and submits them while the next frame is built, texture ids are then the renderer's own and texture data is copied
+	unsigned int createTexture    (const Texture::Type _type, const bool _linear, const bool _repeat, const unsigned int _width, const unsigned int _height, void* _data);
+	void        destroyTexture    (const unsigned int _texture);
+	void        updateTexture     (const unsigned int _texture, const Texture::Type _type, const unsigned int _x, const unsigned _y, const unsigned int _width, const unsigned int _height, void* _data);
+	void        bindTexture       (const unsigned int _texture);
+	bool        canCopyToTexture  (); // false when the copy wouldn't match the screen (rotated screens), draw things directly then
+	void        copyToTexture     (const unsigned int _texture, const int _x, const int _y, const int _width, const int _height); // what has been drawn there so far, rows bottom to top
+	void        drawLines         (const Vertex* _vertices, const unsigned int _numVertices, const Blend::Factor _srcBlendFactor = Blend::SRC_ALPHA, const Blend::Factor _dstBlendFactor = Blend::ONE_MINUS_SRC_ALPHA);
+	void        drawTriangleStrips(const Vertex* _vertices, const unsigned int _numVertices, const Blend::Factor _srcBlendFactor = Blend::SRC_ALPHA, const Blend::Factor _dstBlendFactor = Blend::ONE_MINUS_SRC_ALPHA);
+	void        drawTintedTriangleStrips(const Vertex* _vertices, const unsigned int _numVertices, const unsigned int _color, const Blend::Factor _srcBlendFactor = Blend::SRC_ALPHA, const Blend::Factor _dstBlendFactor = Blend::ONE_MINUS_SRC_ALPHA); // every vertex gets _color
+	void        setMatrix         (const Transform4x4f& _matrix);
+	void        swapBuffers       ();
+	const FrameStats& getFrameStats(); // of the last frame that was swapped
+
+	// counters for the FrameStats of the frame being drawn
+	void        countStateChange   (const bool _skipped); // for the backends' state caches, can be called from the render thread
+	void        countTextCacheBuilt();
+	void        countTransform     (const TransformOp::Type _op);
+	void        countComponent     (const bool _culled);
+	void        countTextureDecoded(); // can be called from any thread
+
 	SDL_Window* getSDLWindow    ();
 	int         getWindowWidth  ();
 	int         getWindowHeight ();
@@ -83,18 +145,26 @@ namespace Renderer
 	void         setupWindow       ();
 	void         createContext     ();
 	void         destroyContext    ();
-	unsigned int createTexture     (const Texture::Type _type, const bool _linear, const bool _repeat, const unsigned int _width, const unsigned int _height, void* _data);
-	void         destroyTexture    (const unsigned int _texture);
-	void         updateTexture     (const unsigned int _texture, const Texture::Type _type, const unsigned int _x, const unsigned _y, const unsigned int _width, const unsigned int _height, void* _data);
-	void         bindTexture       (const unsigned int _texture);
-	void         drawLines         (const Vertex* _vertices, const unsigned int _numVertices, const Blend::Factor _srcBlendFactor = Blend::SRC_ALPHA, const Blend::Factor _dstBlendFactor = Blend::ONE_MINUS_SRC_ALPHA);
-	void         drawTriangleStrips(const Vertex* _vertices, const unsigned int _numVertices, const Blend::Factor _srcBlendFactor = Blend::SRC_ALPHA, const Blend::Factor _dstBlendFactor = Blend::ONE_MINUS_SRC_ALPHA);
-	void         setProjection     (const Transform4x4f& _projection);
-	void         setMatrix         (const Transform4x4f& _matrix);
-	void         setViewport       (const Rect& _viewport);
-	void         setScissor        (const Rect& _scissor);
+	void         setContextCurrent (const bool _current); // on the calling thread, for ThreadedRendering
 	void         setSwapInterval   ();
-	void         swapBuffers       ();
+
+	namespace Backend
+	{
+		// API specific, only used by Renderer.cpp
+		unsigned int createTexture     (const Texture::Type _type, const bool _linear, const bool _repeat, const unsigned int _width, const unsigned int _height, void* _data);
+		void         destroyTexture    (const unsigned int _texture);
+		void         updateTexture     (const unsigned int _texture, const Texture::Type _type, const unsigned int _x, const unsigned _y, const unsigned int _width, const unsigned int _height, void* _data);
+		void         copyToTexture     (const unsigned int _texture, const Rect& _area); // _area in window coordinates
+		void         bindTexture       (const unsigned int _texture);
+		void         drawLines         (const Vertex* _vertices, const unsigned int _numVertices, const Blend::Factor _srcBlendFactor, const Blend::Factor _dstBlendFactor);
+		void         drawTriangleStrips(const Vertex* _vertices, const unsigned int _numVertices, const Blend::Factor _srcBlendFactor, const Blend::Factor _dstBlendFactor);
+		void         setProjection     (const Transform4x4f& _projection);
+		void         setMatrix         (const Transform4x4f& _matrix);
+		void         setViewport       (const Rect& _viewport);
+		void         setScissor        (const Rect& _scissor);
+		void         swapBuffers       ();
+
+	} // Backend::
 
 } // Renderer::
 
@@ -7,6 +7,7 @@
 
 #include <SDL_opengles.h>
 #include <SDL.h>
+#include <string.h>
 
 namespace Renderer
 {
@@ -28,6 +29,95 @@ namespace Renderer
 	static SDL_GLContext sdlContext   = nullptr;
 	static GLuint        whiteTexture = 0;
 
+	// what GL currently has set, so redundant state changes can be skipped
+	static const GLuint  UNKNOWN_TEXTURE = (GLuint)-1;
+	static const GLenum  UNKNOWN_ENUM    = (GLenum)-1;
+
+	static GLuint        currentTexture    = UNKNOWN_TEXTURE;
+	static GLenum        currentSrcBlend   = UNKNOWN_ENUM;
+	static GLenum        currentDstBlend   = UNKNOWN_ENUM;
+	static const Vertex* currentVertices   = nullptr;
+	static GLenum        currentMatrixMode = UNKNOWN_ENUM;
+	static Transform4x4f currentProjection = Transform4x4f::Identity();
+	static Transform4x4f currentModelView  = Transform4x4f::Identity();
+	static bool          projectionKnown   = false;
+	static bool          modelViewKnown    = false;
+	static Rect          currentScissor    = Rect(-1, -1, -1, -1);
+
+	static void resetStateCache()
+	{
+		currentTexture    = UNKNOWN_TEXTURE;
+		currentSrcBlend   = UNKNOWN_ENUM;
+		currentDstBlend   = UNKNOWN_ENUM;
+		currentVertices   = nullptr;
+		currentMatrixMode = UNKNOWN_ENUM;
+		projectionKnown   = false;
+		modelViewKnown    = false;
+		currentScissor    = Rect(-1, -1, -1, -1);
+
+	} // resetStateCache
+
+	static void setTexture(const GLuint _texture)
+	{
+		countStateChange(_texture == currentTexture);
+
+		if(_texture == currentTexture)
+			return;
+
+		GL_CHECK_ERROR(glBindTexture(GL_TEXTURE_2D, _texture));
+		currentTexture = _texture;
+
+	} // setTexture
+
+	static void setBlendFunc(const GLenum _srcBlendFactor, const GLenum _dstBlendFactor)
+	{
+		const bool same = (_srcBlendFactor == currentSrcBlend) && (_dstBlendFactor == currentDstBlend);
+		countStateChange(same);
+
+		if(same)
+			return;
+
+		GL_CHECK_ERROR(glBlendFunc(_srcBlendFactor, _dstBlendFactor));
+		currentSrcBlend = _srcBlendFactor;
+		currentDstBlend = _dstBlendFactor;
+
+	} // setBlendFunc
+
+	static void setVertexPointers(const Vertex* _vertices)
+	{
+		// the batch vertex buffer usually stays where it is from one frame to the next
+		countStateChange(_vertices == currentVertices);
+
+		if(_vertices == currentVertices)
+			return;
+
+		GL_CHECK_ERROR(glVertexPointer(  2, GL_FLOAT,         sizeof(Vertex), &_vertices[0].pos));
+		GL_CHECK_ERROR(glTexCoordPointer(2, GL_FLOAT,         sizeof(Vertex), &_vertices[0].tex));
+		GL_CHECK_ERROR(glColorPointer(   4, GL_UNSIGNED_BYTE, sizeof(Vertex), &_vertices[0].col));
+		currentVertices = _vertices;
+
+	} // setVertexPointers
+
+	static void loadMatrix(const GLenum _mode, const Transform4x4f& _matrix, Transform4x4f& _current, bool& _known)
+	{
+		const bool same = _known && (memcmp(&_matrix, &_current, sizeof(Transform4x4f)) == 0);
+		countStateChange(same);
+
+		if(same)
+			return;
+
+		if(_mode != currentMatrixMode)
+		{
+			GL_CHECK_ERROR(glMatrixMode(_mode));
+			currentMatrixMode = _mode;
+		}
+
+		GL_CHECK_ERROR(glLoadMatrixf((GLfloat*)&_matrix));
+		_current = _matrix;
+		_known   = true;
+
+	} // loadMatrix
+
 	static GLenum convertBlendFactor(const Blend::Factor _blendFactor)
 	{
 		switch(_blendFactor)
@@ -108,8 +198,10 @@ namespace Renderer
 		std::string glExts = glGetString(GL_EXTENSIONS) ? (const char*)glGetString(GL_EXTENSIONS) : "";
 		LOG(LogInfo) << " ARB_texture_non_power_of_two: " << (extensions.find("ARB_texture_non_power_of_two") != std::string::npos ? "ok" : "MISSING");
 
+		resetStateCache();
+
 		uint8_t data[4] = {255, 255, 255, 255};
-		whiteTexture = createTexture(Texture::RGBA, false, true, 1, 1, data);
+		whiteTexture = Backend::createTexture(Texture::RGBA, false, true, 1, 1, data);
 
 		GL_CHECK_ERROR(glClearColor(1.0f, 1.0f, 1.0f, 1.0f));
 		GL_CHECK_ERROR(glEnable(GL_TEXTURE_2D));
@@ -129,13 +221,19 @@ namespace Renderer
 
 	} // destroyContext
 
-	unsigned int createTexture(const Texture::Type _type, const bool _linear, const bool _repeat, const unsigned int _width, const unsigned int _height, void* _data)
+	void setContextCurrent(const bool _current)
+	{
+		SDL_GL_MakeCurrent(getSDLWindow(), _current ? sdlContext : nullptr);
+
+	} // setContextCurrent
+
+	unsigned int Backend::createTexture(const Texture::Type _type, const bool _linear, const bool _repeat, const unsigned int _width, const unsigned int _height, void* _data)
 	{
 		const GLenum type = convertTextureType(_type);
 		unsigned int texture;
 
 		GL_CHECK_ERROR(glGenTextures(1, &texture));
-		GL_CHECK_ERROR(glBindTexture(GL_TEXTURE_2D, texture));
+		setTexture(texture);
 
 		GL_CHECK_ERROR(glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, _repeat ? GL_REPEAT : GL_CLAMP_TO_EDGE));
 		GL_CHECK_ERROR(glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, _repeat ? GL_REPEAT : GL_CLAMP_TO_EDGE));
@@ -149,79 +247,90 @@ namespace Renderer
 
 	} // createTexture
 
-	void destroyTexture(const unsigned int _texture)
+	void Backend::destroyTexture(const unsigned int _texture)
 	{
 		GL_CHECK_ERROR(glDeleteTextures(1, &_texture));
 
+		// GL falls back to texture 0 when the bound texture is deleted
+		if(_texture == currentTexture)
+			currentTexture = UNKNOWN_TEXTURE;
+
 	} // destroyTexture
 
-	void updateTexture(const unsigned int _texture, const Texture::Type _type, const unsigned int _x, const unsigned _y, const unsigned int _width, const unsigned int _height, void* _data)
+	void Backend::updateTexture(const unsigned int _texture, const Texture::Type _type, const unsigned int _x, const unsigned _y, const unsigned int _width, const unsigned int _height, void* _data)
 	{
 		const GLenum type = convertTextureType(_type);
 
-		GL_CHECK_ERROR(glBindTexture(GL_TEXTURE_2D, _texture));
+		// Renderer.cpp binds the right texture before every draw, no need to go back to the previous one
+		setTexture(_texture);
 		GL_CHECK_ERROR(glTexSubImage2D(GL_TEXTURE_2D, 0, _x, _y, _width, _height, type, GL_UNSIGNED_BYTE, _data));
-		GL_CHECK_ERROR(glBindTexture(GL_TEXTURE_2D, whiteTexture));
 
 	} // updateTexture
 
-	void bindTexture(const unsigned int _texture)
+	void Backend::copyToTexture(const unsigned int _texture, const Rect& _area)
 	{
-		if(_texture == 0) GL_CHECK_ERROR(glBindTexture(GL_TEXTURE_2D, whiteTexture));
-		else              GL_CHECK_ERROR(glBindTexture(GL_TEXTURE_2D, _texture));
+		// glCopyTexSubImage2D starts at the bottom left of the window, so the rows end up bottom to top
+		setTexture(_texture);
+		GL_CHECK_ERROR(glCopyTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, _area.x, getWindowHeight() - _area.y - _area.h, _area.w, _area.h));
 
-	} // bindTexture
+	} // copyToTexture
 
-	void drawLines(const Vertex* _vertices, const unsigned int _numVertices, const Blend::Factor _srcBlendFactor, const Blend::Factor _dstBlendFactor)
+	void Backend::bindTexture(const unsigned int _texture)
 	{
-		GL_CHECK_ERROR(glVertexPointer(  2, GL_FLOAT,         sizeof(Vertex), &_vertices[0].pos));
-		GL_CHECK_ERROR(glTexCoordPointer(2, GL_FLOAT,         sizeof(Vertex), &_vertices[0].tex));
-		GL_CHECK_ERROR(glColorPointer(   4, GL_UNSIGNED_BYTE, sizeof(Vertex), &_vertices[0].col));
+		setTexture((_texture == 0) ? whiteTexture : _texture);
+
+	} // bindTexture
 
-		GL_CHECK_ERROR(glBlendFunc(convertBlendFactor(_srcBlendFactor), convertBlendFactor(_dstBlendFactor)));
+	void Backend::drawLines(const Vertex* _vertices, const unsigned int _numVertices, const Blend::Factor _srcBlendFactor, const Blend::Factor _dstBlendFactor)
+	{
+		setVertexPointers(_vertices);
+		setBlendFunc(convertBlendFactor(_srcBlendFactor), convertBlendFactor(_dstBlendFactor));
 
 		GL_CHECK_ERROR(glDrawArrays(GL_LINES, 0, _numVertices));
 
 	} // drawLines
 
-	void drawTriangleStrips(const Vertex* _vertices, const unsigned int _numVertices, const Blend::Factor _srcBlendFactor, const Blend::Factor _dstBlendFactor)
+	void Backend::drawTriangleStrips(const Vertex* _vertices, const unsigned int _numVertices, const Blend::Factor _srcBlendFactor, const Blend::Factor _dstBlendFactor)
 	{
-		GL_CHECK_ERROR(glVertexPointer(  2, GL_FLOAT,         sizeof(Vertex), &_vertices[0].pos));
-		GL_CHECK_ERROR(glTexCoordPointer(2, GL_FLOAT,         sizeof(Vertex), &_vertices[0].tex));
-		GL_CHECK_ERROR(glColorPointer(   4, GL_UNSIGNED_BYTE, sizeof(Vertex), &_vertices[0].col));
-
-		GL_CHECK_ERROR(glBlendFunc(convertBlendFactor(_srcBlendFactor), convertBlendFactor(_dstBlendFactor)));
+		setVertexPointers(_vertices);
+		setBlendFunc(convertBlendFactor(_srcBlendFactor), convertBlendFactor(_dstBlendFactor));
 
 		GL_CHECK_ERROR(glDrawArrays(GL_TRIANGLE_STRIP, 0, _numVertices));
 
 	} // drawTriangleStrips
 
-	void setProjection(const Transform4x4f& _projection)
+	void Backend::setProjection(const Transform4x4f& _projection)
 	{
-		GL_CHECK_ERROR(glMatrixMode(GL_PROJECTION));
-		GL_CHECK_ERROR(glLoadMatrixf((GLfloat*)&_projection));
+		loadMatrix(GL_PROJECTION, _projection, currentProjection, projectionKnown);
 
 	} // setProjection
 
-	void setMatrix(const Transform4x4f& _matrix)
+	void Backend::setMatrix(const Transform4x4f& _matrix)
 	{
 		Transform4x4f matrix = _matrix;
 		matrix.round();
 
-		GL_CHECK_ERROR(glMatrixMode(GL_MODELVIEW));
-		GL_CHECK_ERROR(glLoadMatrixf((GLfloat*)&matrix));
+		loadMatrix(GL_MODELVIEW, matrix, currentModelView, modelViewKnown);
 
 	} // setMatrix
 
-	void setViewport(const Rect& _viewport)
+	void Backend::setViewport(const Rect& _viewport)
 	{
 		// glViewport starts at the bottom left of the window
 		GL_CHECK_ERROR(glViewport( _viewport.x, getWindowHeight() - _viewport.y - _viewport.h, _viewport.w, _viewport.h));
 
 	} // setViewport
 
-	void setScissor(const Rect& _scissor)
+	void Backend::setScissor(const Rect& _scissor)
 	{
+		const bool same = (_scissor.x == currentScissor.x) && (_scissor.y == currentScissor.y) && (_scissor.w == currentScissor.w) && (_scissor.h == currentScissor.h);
+		countStateChange(same);
+
+		if(same)
+			return;
+
+		currentScissor = _scissor;
+
 		if((_scissor.x == 0) && (_scissor.y == 0) && (_scissor.w == 0) && (_scissor.h == 0))
 		{
 			GL_CHECK_ERROR(glDisable(GL_SCISSOR_TEST));
@@ -254,7 +363,7 @@ namespace Renderer
 
 	} // setSwapInterval
 
-	void swapBuffers()
+	void Backend::swapBuffers()
 	{
 		SDL_GL_SwapWindow(getSDLWindow());
 		GL_CHECK_ERROR(glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT));
@@ -0,0 +1,507 @@
+#if defined(USE_RENDERER_NULL)
+
+#include "renderers/Renderer.h"
+#include "math/Misc.h"
+#include "math/Transform4x4f.h"
+#include "utils/FileSystemUtil.h"
+#include "Log.h"
+#include "Settings.h"
+
+#include <SDL.h>
+#include <map>
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+#include <vector>
+
+// Headless backend, doesn't need a GL context (run with SDL_VIDEODRIVER=dummy on machines without a display).
+// Textures are kept in memory and draw calls are dropped, unless FrameCapturePath is set, then everything is
+// rasterized in software and every swapped frame is written to that directory as a PPM image.
+
+namespace Renderer
+{
+	struct SoftTexture
+	{
+		Texture::Type              type;
+		bool                       repeat;
+		unsigned int               width;
+		unsigned int               height;
+		std::vector<unsigned char> data;
+
+	}; // SoftTexture
+
+	static std::map<unsigned int, SoftTexture> textures;
+	static unsigned int                        nextTexture     = 1;
+	static const SoftTexture*                  boundTexture    = nullptr;
+	static Transform4x4f                       projection      = Transform4x4f::Identity();
+	static Transform4x4f                       modelView       = Transform4x4f::Identity();
+	static Rect                                viewport        = Rect(0, 0, 0, 0);
+	static Rect                                scissor         = Rect(0, 0, 0, 0);
+	static std::vector<unsigned char>          frameBuffer;
+	static std::string                         capturePath;
+	static unsigned int                        frameCount      = 0;
+
+	static float blendFactor(const Blend::Factor _blendFactor, const float* _src, const float* _dst, const int _channel)
+	{
+		switch(_blendFactor)
+		{
+			case Blend::ZERO:                { return 0.0f;                  } break;
+			case Blend::ONE:                 { return 1.0f;                  } break;
+			case Blend::SRC_COLOR:           { return _src[_channel];        } break;
+			case Blend::ONE_MINUS_SRC_COLOR: { return 1.0f - _src[_channel]; } break;
+			case Blend::SRC_ALPHA:           { return _src[3];               } break;
+			case Blend::ONE_MINUS_SRC_ALPHA: { return 1.0f - _src[3];        } break;
+			case Blend::DST_COLOR:           { return _dst[_channel];        } break;
+			case Blend::ONE_MINUS_DST_COLOR: { return 1.0f - _dst[_channel]; } break;
+			case Blend::DST_ALPHA:           { return _dst[3];               } break;
+			case Blend::ONE_MINUS_DST_ALPHA: { return 1.0f - _dst[3];        } break;
+			default:                         { return 0.0f;                  }
+		}
+
+	} // blendFactor
+
+	static void sampleTexture(const float _u, const float _v, float* _texel)
+	{
+		_texel[0] = _texel[1] = _texel[2] = _texel[3] = 1.0f;
+
+		if((boundTexture == nullptr) || boundTexture->data.empty())
+			return;
+
+		// nearest filtering
+		int x = (int)floorf(_u * boundTexture->width);
+		int y = (int)floorf(_v * boundTexture->height);
+
+		if(boundTexture->repeat)
+		{
+			x %= (int)boundTexture->width;  if(x < 0) x += boundTexture->width;
+			y %= (int)boundTexture->height; if(y < 0) y += boundTexture->height;
+		}
+		else
+		{
+			x = Math::max(0, Math::min(x, (int)boundTexture->width  - 1));
+			y = Math::max(0, Math::min(y, (int)boundTexture->height - 1));
+		}
+
+		// alpha textures modulate only the alpha, like GL_ALPHA does
+		if(boundTexture->type == Texture::ALPHA)
+		{
+			_texel[3] = boundTexture->data[y * boundTexture->width + x] / 255.0f;
+		}
+		else
+		{
+			const unsigned char* p = &boundTexture->data[(y * boundTexture->width + x) * 4];
+			for(int i = 0; i < 4; ++i)
+				_texel[i] = p[i] / 255.0f;
+		}
+
+	} // sampleTexture
+
+	static void plot(const int _x, const int _y, const float* _color, const Blend::Factor _srcBlendFactor, const Blend::Factor _dstBlendFactor)
+	{
+		unsigned char* p = &frameBuffer[(_y * getWindowWidth() + _x) * 4];
+		float          dst[4];
+		float          src[4];
+
+		for(int i = 0; i < 4; ++i)
+			dst[i] = p[i] / 255.0f;
+
+		// blend factors use the unblended source and destination
+		for(int i = 0; i < 4; ++i)
+			src[i] = Math::clamp(_color[i], 0.0f, 1.0f);
+
+		for(int i = 0; i < 4; ++i)
+		{
+			const float value = (src[i] * blendFactor(_srcBlendFactor, src, dst, i)) + (dst[i] * blendFactor(_dstBlendFactor, src, dst, i));
+			p[i] = (unsigned char)(Math::clamp(value, 0.0f, 1.0f) * 255.0f + 0.5f);
+		}
+
+	} // plot
+
+	static bool getDrawArea(int& _x1_out, int& _y1_out, int& _x2_out, int& _y2_out)
+	{
+		_x1_out = 0;
+		_y1_out = 0;
+		_x2_out = getWindowWidth();
+		_y2_out = getWindowHeight();
+
+		if((scissor.w != 0) || (scissor.h != 0))
+		{
+			_x1_out = Math::max(_x1_out, scissor.x);
+			_y1_out = Math::max(_y1_out, scissor.y);
+			_x2_out = Math::min(_x2_out, scissor.x + scissor.w);
+			_y2_out = Math::min(_y2_out, scissor.y + scissor.h);
+		}
+
+		return (_x1_out < _x2_out) && (_y1_out < _y2_out);
+
+	} // getDrawArea
+
+	static Vector2f toWindow(const Vector2f& _pos)
+	{
+		// projection * modelView, then the viewport, with y going down like the window
+		const Vector3f ndc = projection * (modelView * Vector3f(_pos.x(), _pos.y(), 0.0f));
+
+		return Vector2f(viewport.x + ((ndc.x() + 1.0f) * 0.5f * viewport.w), viewport.y + ((1.0f - ndc.y()) * 0.5f * viewport.h));
+
+	} // toWindow
+
+	static void unpackColor(const unsigned int _color, float* _color_out)
+	{
+		// vertex colors are in convertColor() order
+		_color_out[0] = ((_color      ) & 255) / 255.0f;
+		_color_out[1] = ((_color >>  8) & 255) / 255.0f;
+		_color_out[2] = ((_color >> 16) & 255) / 255.0f;
+		_color_out[3] = ((_color >> 24) & 255) / 255.0f;
+
+	} // unpackColor
+
+	static bool insideEdge(const float _weight, const Vector2f& _start, const Vector2f& _end, const float _area)
+	{
+		if(_weight != 0.0f)
+			return _weight > 0.0f;
+
+		// a pixel center right on an edge shared by two triangles (the diagonal of every quad) goes to only one of them,
+		// the edge runs in opposite directions in the two once both are wound the same way
+		const float dx = (_area > 0.0f) ? (_end.x() - _start.x()) : (_start.x() - _end.x());
+		const float dy = (_area > 0.0f) ? (_end.y() - _start.y()) : (_start.y() - _end.y());
+
+		return (dy > 0.0f) || ((dy == 0.0f) && (dx < 0.0f));
+
+	} // insideEdge
+
+	static void rasterizeTriangle(const Vertex* _v0, const Vertex* _v1, const Vertex* _v2, const Blend::Factor _srcBlendFactor, const Blend::Factor _dstBlendFactor)
+	{
+		const Vector2f p0   = toWindow(_v0->pos);
+		const Vector2f p1   = toWindow(_v1->pos);
+		const Vector2f p2   = toWindow(_v2->pos);
+		const float    area = ((p1.x() - p0.x()) * (p2.y() - p0.y())) - ((p2.x() - p0.x()) * (p1.y() - p0.y()));
+
+		if(area == 0.0f)
+			return;
+
+		int areaX1, areaY1, areaX2, areaY2;
+		if(!getDrawArea(areaX1, areaY1, areaX2, areaY2))
+			return;
+
+		const int x1 = Math::max(areaX1, (int)floorf(Math::min(p0.x(), Math::min(p1.x(), p2.x()))));
+		const int y1 = Math::max(areaY1, (int)floorf(Math::min(p0.y(), Math::min(p1.y(), p2.y()))));
+		const int x2 = Math::min(areaX2, (int)ceilf( Math::max(p0.x(), Math::max(p1.x(), p2.x()))));
+		const int y2 = Math::min(areaY2, (int)ceilf( Math::max(p0.y(), Math::max(p1.y(), p2.y()))));
+
+		float c0[4], c1[4], c2[4];
+		unpackColor(_v0->col, c0);
+		unpackColor(_v1->col, c1);
+		unpackColor(_v2->col, c2);
+
+		for(int y = y1; y < y2; ++y)
+		{
+			for(int x = x1; x < x2; ++x)
+			{
+				// barycentric coordinates of the pixel center, dividing by the area takes care of the winding
+				const float px = x + 0.5f;
+				const float py = y + 0.5f;
+				const float w0 = (((p1.x() - px) * (p2.y() - py)) - ((p2.x() - px) * (p1.y() - py))) / area;
+				const float w1 = (((p2.x() - px) * (p0.y() - py)) - ((p0.x() - px) * (p2.y() - py))) / area;
+				const float w2 = (((p0.x() - px) * (p1.y() - py)) - ((p1.x() - px) * (p0.y() - py))) / area;
+
+				if(!insideEdge(w0, p1, p2, area) || !insideEdge(w1, p2, p0, area) || !insideEdge(w2, p0, p1, area))
+					continue;
+
+				float texel[4];
+				sampleTexture((_v0->tex.x() * w0) + (_v1->tex.x() * w1) + (_v2->tex.x() * w2), (_v0->tex.y() * w0) + (_v1->tex.y() * w1) + (_v2->tex.y() * w2), texel);
+
+				float color[4];
+				for(int i = 0; i < 4; ++i)
+					color[i] = ((c0[i] * w0) + (c1[i] * w1) + (c2[i] * w2)) * texel[i];
+
+				plot(x, y, color, _srcBlendFactor, _dstBlendFactor);
+			}
+		}
+
+	} // rasterizeTriangle
+
+	static void rasterizeLine(const Vertex* _v0, const Vertex* _v1, const Blend::Factor _srcBlendFactor, const Blend::Factor _dstBlendFactor)
+	{
+		const Vector2f p0    = toWindow(_v0->pos);
+		const Vector2f p1    = toWindow(_v1->pos);
+		const int      steps = Math::max(1, (int)ceilf(Math::max(fabsf(p1.x() - p0.x()), fabsf(p1.y() - p0.y()))));
+
+		int areaX1, areaY1, areaX2, areaY2;
+		if(!getDrawArea(areaX1, areaY1, areaX2, areaY2))
+			return;
+
+		float c0[4], c1[4];
+		unpackColor(_v0->col, c0);
+		unpackColor(_v1->col, c1);
+
+		for(int i = 0; i < steps; ++i)
+		{
+			const float t = (i + 0.5f) / steps;
+			const int   x = (int)floorf(Math::lerp(p0.x(), p1.x(), t));
+			const int   y = (int)floorf(Math::lerp(p0.y(), p1.y(), t));
+
+			if((x < areaX1) || (x >= areaX2) || (y < areaY1) || (y >= areaY2))
+				continue;
+
+			float color[4];
+			for(int j = 0; j < 4; ++j)
+				color[j] = Math::lerp(c0[j], c1[j], t);
+
+			plot(x, y, color, _srcBlendFactor, _dstBlendFactor);
+		}
+
+	} // rasterizeLine
+
+	static void writeFrame()
+	{
+		char fileName[32];
+		snprintf(fileName, sizeof(fileName), "/frame_%06u.ppm", frameCount);
+
+		const std::string path = capturePath + fileName;
+		FILE*             file = fopen(path.c_str(), "wb");
+
+		if(file == nullptr)
+		{
+			LOG(LogError) << "Could not write frame capture " << path;
+			return;
+		}
+
+		fprintf(file, "P6\n%d %d\n255\n", getWindowWidth(), getWindowHeight());
+
+		std::vector<unsigned char> row(getWindowWidth() * 3);
+		for(int y = 0; y < getWindowHeight(); ++y)
+		{
+			const unsigned char* src = &frameBuffer[y * getWindowWidth() * 4];
+			for(int x = 0; x < getWindowWidth(); ++x)
+			{
+				row[x * 3 + 0] = src[x * 4 + 0];
+				row[x * 3 + 1] = src[x * 4 + 1];
+				row[x * 3 + 2] = src[x * 4 + 2];
+			}
+			fwrite(row.data(), 1, row.size(), file);
+		}
+
+		fclose(file);
+
+	} // writeFrame
+
+	static void clearFrame()
+	{
+		// same white as the GL backends' glClearColor
+		if(!capturePath.empty())
+			frameBuffer.assign(getWindowWidth() * getWindowHeight() * 4, 255);
+
+	} // clearFrame
+
+	unsigned int convertColor(const unsigned int _color)
+	{
+		// convert from rgba to abgr
+		unsigned char r = ((_color & 0xff000000) >> 24) & 255;
+		unsigned char g = ((_color & 0x00ff0000) >> 16) & 255;
+		unsigned char b = ((_color & 0x0000ff00) >>  8) & 255;
+		unsigned char a = ((_color & 0x000000ff)      ) & 255;
+
+		return ((a << 24) | (b << 16) | (g << 8) | (r));
+
+	} // convertColor
+
+	unsigned int getWindowFlags()
+	{
+		return SDL_WINDOW_HIDDEN;
+
+	} // getWindowFlags
+
+	void setupWindow()
+	{
+		// no context to set up
+
+	} // setupWindow
+
+	void createContext()
+	{
+		capturePath = Settings::getInstance()->getString("FrameCapturePath");
+		frameCount  = 0;
+
+		LOG(LogInfo) << "Using the headless renderer";
+
+		if(!capturePath.empty())
+		{
+			if(!Utils::FileSystem::exists(capturePath))
+				Utils::FileSystem::createDirectory(capturePath);
+
+			LOG(LogInfo) << "Capturing frames to " << capturePath;
+		}
+
+		clearFrame();
+
+	} // createContext
+
+	void destroyContext()
+	{
+		textures.clear();
+		boundTexture = nullptr;
+		std::vector<unsigned char>().swap(frameBuffer);
+
+	} // destroyContext
+
+	void setContextCurrent(const bool /*_current*/)
+	{
+		// no context to move between threads
+
+	} // setContextCurrent
+
+	unsigned int Backend::createTexture(const Texture::Type _type, const bool /*_linear*/, const bool _repeat, const unsigned int _width, const unsigned int _height, void* _data)
+	{
+		const unsigned int texture = nextTexture++;
+		SoftTexture&       tex     = textures[texture];
+
+		tex.type   = _type;
+		tex.repeat = _repeat;
+		tex.width  = _width;
+		tex.height = _height;
+		tex.data.assign(_width * _height * ((_type == Texture::ALPHA) ? 1 : 4), 0);
+
+		if(_data != nullptr)
+			memcpy(tex.data.data(), _data, tex.data.size());
+
+		return texture;
+
+	} // createTexture
+
+	void Backend::destroyTexture(const unsigned int _texture)
+	{
+		auto it = textures.find(_texture);
+		if(it == textures.cend())
+			return;
+
+		if(boundTexture == &it->second)
+			boundTexture = nullptr;
+
+		textures.erase(it);
+
+	} // destroyTexture
+
+	void Backend::updateTexture(const unsigned int _texture, const Texture::Type _type, const unsigned int _x, const unsigned _y, const unsigned int _width, const unsigned int _height, void* _data)
+	{
+		auto it = textures.find(_texture);
+		if((it == textures.cend()) || (_data == nullptr))
+			return;
+
+		SoftTexture&       tex   = it->second;
+		const unsigned int bpp   = (_type == Texture::ALPHA) ? 1 : 4;
+
+		if(_x >= tex.width)
+			return;
+
+		// anything outside of the texture is dropped
+		const unsigned int width = ((_x + _width) > tex.width) ? (tex.width - _x) : _width;
+
+		for(unsigned int y = 0; (y < _height) && ((_y + y) < tex.height); ++y)
+			memcpy(&tex.data[((_y + y) * tex.width + _x) * bpp], (const unsigned char*)_data + (y * _width * bpp), width * bpp);
+
+	} // updateTexture
+
+	void Backend::copyToTexture(const unsigned int _texture, const Rect& _area)
+	{
+		auto it = textures.find(_texture);
+		if((it == textures.cend()) || frameBuffer.empty())
+			return;
+
+		SoftTexture&       tex = it->second;
+		const unsigned int bpp = (tex.type == Texture::ALPHA) ? 1 : 4;
+
+		// rows bottom to top like the GL backends, anything outside of the window or the texture is dropped
+		for(int y = 0; (y < _area.h) && (y < (int)tex.height); ++y)
+		{
+			const int windowY = _area.y + _area.h - 1 - y;
+			if((windowY < 0) || (windowY >= getWindowHeight()))
+				continue;
+
+			for(int x = 0; (x < _area.w) && (x < (int)tex.width); ++x)
+			{
+				const int windowX = _area.x + x;
+				if((windowX < 0) || (windowX >= getWindowWidth()))
+					continue;
+
+				const unsigned char* src = &frameBuffer[(windowY * getWindowWidth() + windowX) * 4];
+				unsigned char*       dst = &tex.data[(y * tex.width + x) * bpp];
+
+				if(bpp == 1) dst[0] = src[3];
+				else         memcpy(dst, src, 4);
+			}
+		}
+
+	} // copyToTexture
+
+	void Backend::bindTexture(const unsigned int _texture)
+	{
+		auto it = textures.find(_texture);
+		boundTexture = (it != textures.cend()) ? &it->second : nullptr;
+
+	} // bindTexture
+
+	void Backend::drawLines(const Vertex* _vertices, const unsigned int _numVertices, const Blend::Factor _srcBlendFactor, const Blend::Factor _dstBlendFactor)
+	{
+		if(capturePath.empty())
+			return;
+
+		for(unsigned int i = 0; (i + 1) < _numVertices; i += 2)
+			rasterizeLine(&_vertices[i], &_vertices[i + 1], _srcBlendFactor, _dstBlendFactor);
+
+	} // drawLines
+
+	void Backend::drawTriangleStrips(const Vertex* _vertices, const unsigned int _numVertices, const Blend::Factor _srcBlendFactor, const Blend::Factor _dstBlendFactor)
+	{
+		if(capturePath.empty())
+			return;
+
+		for(unsigned int i = 0; (i + 2) < _numVertices; ++i)
+			rasterizeTriangle(&_vertices[i], &_vertices[i + 1], &_vertices[i + 2], _srcBlendFactor, _dstBlendFactor);
+
+	} // drawTriangleStrips
+
+	void Backend::setProjection(const Transform4x4f& _projection)
+	{
+		projection = _projection;
+
+	} // setProjection
+
+	void Backend::setMatrix(const Transform4x4f& _matrix)
+	{
+		modelView = _matrix;
+		modelView.round();
+
+	} // setMatrix
+
+	void Backend::setViewport(const Rect& _viewport)
+	{
+		viewport = _viewport;
+
+	} // setViewport
+
+	void Backend::setScissor(const Rect& _scissor)
+	{
+		scissor = _scissor;
+
+	} // setScissor
+
+	void setSwapInterval()
+	{
+		// nothing to sync to
+
+	} // setSwapInterval
+
+	void Backend::swapBuffers()
+	{
+		if(!capturePath.empty())
+			writeFrame();
+
+		frameCount++;
+
+		clearFrame();
+
+	} // swapBuffers
+
+} // Renderer::
+
+#endif // USE_RENDERER_NULL
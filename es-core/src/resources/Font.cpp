@@ -4,9 +4,15 @@
 #include "utils/FileSystemUtil.h"
 #include "utils/StringUtil.h"
 #include "Log.h"
+#include <fstream>
 
 #ifdef WIN32
 #include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 #endif
 
 FT_Library Font::sLibrary = NULL;
@@ -14,20 +20,88 @@ FT_Library Font::sLibrary = NULL;
 int Font::getSize() const { return mSize; }
 
 std::map< std::pair<std::string, int>, std::weak_ptr<Font> > Font::sFontMap;
+std::map< std::string, std::weak_ptr<Font::FontFile> > Font::sFontFiles;
+std::mutex Font::sFreeTypeMutex;
+GlyphRasterizer Font::sRasterizer;
+
+std::unordered_map<Font::TextCacheKey, Font::TextCacheEntry, Font::TextCacheKeyHash> Font::sTextCacheMap;
+std::list<const Font::TextCacheKey*> Font::sTextCacheLRU;
+size_t Font::sTextCacheMemUsage = 0;
 
-Font::FontFace::FontFace(ResourceData&& d, int size) : data(d)
+Font::FontFile::FontFile(const std::string& path) : data(NULL), length(0), mapped(false), face(NULL), hash(0), hashed(false)
 {
-	int err = FT_New_Memory_Face(sLibrary, data.ptr.get(), (FT_Long)data.length, 0, &face);
-	assert(!err);
+	const std::string resPath = ResourceManager::getInstance()->getResourcePath(path);
 
-	if(!err)
-		FT_Set_Pixel_Sizes(face, 0, size);
+#ifndef WIN32
+	int fd = open(resPath.c_str(), O_RDONLY);
+	if(fd >= 0)
+	{
+		struct stat info;
+		if(fstat(fd, &info) == 0 && info.st_size > 0)
+		{
+			void* map = mmap(NULL, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+			if(map != MAP_FAILED)
+			{
+				data = (const unsigned char*)map;
+				length = (size_t)info.st_size;
+				mapped = true;
+			}
+		}
+
+		close(fd);
+	}
+#endif
+
+	if(!mapped)
+	{
+		ResourceData resource = ResourceManager::getInstance()->getFileData(resPath);
+		buffer = resource.ptr;
+		data = buffer.get();
+		length = resource.length;
+	}
+
+	if(!data || FT_New_Memory_Face(sLibrary, data, (FT_Long)length, 0, &face))
+	{
+		LOG(LogError) << "Could not load font face " << path;
+		face = NULL;
+	}
 }
 
-Font::FontFace::~FontFace()
+Font::FontFile::~FontFile()
 {
 	if(face)
 		FT_Done_Face(face);
+
+#ifndef WIN32
+	if(mapped)
+		munmap((void*)data, length);
+#endif
+}
+
+std::shared_ptr<Font::FontFile> Font::getFontFile(const std::string& path)
+{
+	auto it = sFontFiles.find(path);
+	if(it != sFontFiles.cend() && !it->second.expired())
+		return it->second.lock();
+
+	std::shared_ptr<FontFile> file = std::make_shared<FontFile>(path);
+	sFontFiles[path] = file;
+	return file;
+}
+
+Font::FontFace::FontFace(const std::shared_ptr<FontFile>& f, int pixelSize) : file(f), size(NULL)
+{
+	if(file->face && !FT_New_Size(file->face, &size))
+	{
+		FT_Activate_Size(size);
+		FT_Set_Pixel_Sizes(file->face, 0, pixelSize);
+	}
+}
+
+Font::FontFace::~FontFace()
+{
+	if(size)
+		FT_Done_Size(size);
 }
 
 void Font::initLibrary()
@@ -43,11 +117,8 @@ void Font::initLibrary()
 size_t Font::getMemUsage() const
 {
 	size_t memUsage = 0;
-	for(auto it = mTextures.cbegin(); it != mTextures.cend(); it++)
-		memUsage += it->textureSize.x() * it->textureSize.y() * 4;
-
-	for(auto it = mFaceCache.cbegin(); it != mFaceCache.cend(); it++)
-		memUsage += it->second->data.length;
+	memUsage += mGlyphs.capacity() * sizeof(Glyph);
+	memUsage += mGlyphBitmaps.capacity();
 
 	return memUsage;
 }
@@ -69,6 +140,22 @@ size_t Font::getTotalMemUsage()
 		it++;
 	}
 
+	total += GlyphAtlas::getInstance()->getMemUsage();
+
+	// font files are shared between fonts, count them once
+	std::unique_lock<std::mutex> lock(sFreeTypeMutex);
+	for(auto fit = sFontFiles.cbegin(); fit != sFontFiles.cend(); )
+	{
+		if(fit->second.expired())
+		{
+			fit = sFontFiles.erase(fit);
+			continue;
+		}
+
+		total += fit->second.lock()->length;
+		fit++;
+	}
+
 	return total;
 }
 
@@ -78,29 +165,54 @@ Font::Font(int size, const std::string& path) : mSize(size), mPath(path)
 
 	mMaxGlyphHeight = 0;
 
+	for(unsigned int i = 0; i < GLYPH_DIRECT_COUNT; i++)
+		mGlyphDirect[i] = GLYPH_NONE;
+
+	mGlyphHash.assign(64, { 0, GLYPH_NONE });
+	mGlyphHashCount = 0;
+	mGlyphs.reserve(GLYPH_DIRECT_COUNT);
+
 	if(!sLibrary)
 		initLibrary();
 
+	mGlyphArrivals = 0;
+
+	{
+		// the font's own face is needed for any glyph the cache doesn't have anyway, opening it now keeps the file
+		// mapped for the hash and the face alike
+		std::unique_lock<std::mutex> lock(sFreeTypeMutex);
+		std::shared_ptr<FontFile> file = getFontFile(mPath);
+		mFaceCache[0] = std::unique_ptr<FontFace>(new FontFace(file, mSize));
+		mGlyphCacheHash = hashFontFiles(*file);
+	}
+
+	mGlyphCacheDirty = false;
+	loadGlyphCache();
+
 	// always initialize ASCII characters
 	for(unsigned int i = 32; i < 128; i++)
-		getGlyph(i);
-
-	clearFaceCache();
+		getGlyph(i, false);
 }
 
 Font::~Font()
 {
+	sRasterizer.cancel(this);
+	removeTextCaches();
 	unload(ResourceManager::getInstance());
 }
 
 void Font::reload(std::shared_ptr<ResourceManager>& /*rm*/)
 {
-	rebuildTextures();
+	// the glyph atlas was cleared on unload, glyphs and text caches are placed again as they get used
 }
 
 void Font::unload(std::shared_ptr<ResourceManager>& /*rm*/)
 {
-	unloadTextures();
+	if(mGlyphCacheDirty)
+		saveGlyphCache();
+
+	// faces are cheap to keep while running but there's no point in holding on to font files while a game is
+	clearFaceCache();
 }
 
 std::shared_ptr<Font> Font::get(int size, const std::string& path)
@@ -121,98 +233,6 @@ std::shared_ptr<Font> Font::get(int size, const std::string& path)
 	return font;
 }
 
-void Font::unloadTextures()
-{
-	for(auto it = mTextures.begin(); it != mTextures.end(); it++)
-	{
-		it->deinitTexture();
-	}
-}
-
-Font::FontTexture::FontTexture()
-{
-	textureId = 0;
-	textureSize = Vector2i(2048, 512);
-	writePos = Vector2i::Zero();
-	rowHeight = 0;
-}
-
-Font::FontTexture::~FontTexture()
-{
-	deinitTexture();
-}
-
-bool Font::FontTexture::findEmpty(const Vector2i& size, Vector2i& cursor_out)
-{
-	if(size.x() >= textureSize.x() || size.y() >= textureSize.y())
-		return false;
-
-	if(writePos.x() + size.x() >= textureSize.x() &&
-		writePos.y() + rowHeight + size.y() + 1 < textureSize.y())
-	{
-		// row full, but it should fit on the next row
-		// move cursor to next row
-		writePos = Vector2i(0, writePos.y() + rowHeight + 1); // leave 1px of space between glyphs
-		rowHeight = 0;
-	}
-
-	if(writePos.x() + size.x() >= textureSize.x() ||
-		writePos.y() + size.y() >= textureSize.y())
-	{
-		// nope, still won't fit
-		return false;
-	}
-
-	cursor_out = writePos;
-	writePos[0] += size.x() + 1; // leave 1px of space between glyphs
-
-	if(size.y() > rowHeight)
-		rowHeight = size.y();
-
-	return true;
-}
-
-void Font::FontTexture::initTexture()
-{
-	assert(textureId == 0);
-	textureId = Renderer::createTexture(Renderer::Texture::ALPHA, false, false, textureSize.x(), textureSize.y(), nullptr);
-}
-
-void Font::FontTexture::deinitTexture()
-{
-	if(textureId != 0)
-	{
-		Renderer::destroyTexture(textureId);
-		textureId = 0;
-	}
-}
-
-void Font::getTextureForNewGlyph(const Vector2i& glyphSize, FontTexture*& tex_out, Vector2i& cursor_out)
-{
-	if(mTextures.size())
-	{
-		// check if the most recent texture has space
-		tex_out = &mTextures.back();
-
-		// will this one work?
-		if(tex_out->findEmpty(glyphSize, cursor_out))
-			return; // yes
-	}
-
-	// current textures are full,
-	// make a new one
-	mTextures.push_back(FontTexture());
-	tex_out = &mTextures.back();
-	tex_out->initTexture();
-
-	bool ok = tex_out->findEmpty(glyphSize, cursor_out);
-	if(!ok)
-	{
-		LOG(LogError) << "Glyph too big to fit on a new texture (glyph size > " << tex_out->textureSize.x() << ", " << tex_out->textureSize.y() << ")!";
-		tex_out = NULL;
-	}
-}
-
 std::vector<std::string> getFallbackFontPaths()
 {
 #ifdef WIN32
@@ -281,37 +301,202 @@ FT_Face Font::getFaceForChar(unsigned int id)
 			// i == 0 -> mPath
 			// otherwise, take from fallbackFonts
 			const std::string& path = (i == 0 ? mPath : fallbackFonts.at(i - 1));
-			ResourceData data = ResourceManager::getInstance()->getFileData(path);
-			mFaceCache[i] = std::unique_ptr<FontFace>(new FontFace(std::move(data), mSize));
+			mFaceCache[i] = std::unique_ptr<FontFace>(new FontFace(getFontFile(path), mSize));
 			fit = mFaceCache.find(i);
 		}
 
-		if(FT_Get_Char_Index(fit->second->face, id) != 0)
-			return fit->second->face;
+		FT_Face face = fit->second->file->face;
+		if(face && fit->second->size && FT_Get_Char_Index(face, id) != 0)
+		{
+			FT_Activate_Size(fit->second->size);
+			return face;
+		}
 	}
 
 	// nothing has a valid glyph - return the "real" face so we get a "missing" character
-	return mFaceCache.cbegin()->second->face;
+	const FontFace* realFace = mFaceCache.cbegin()->second.get();
+	if(!realFace->size)
+		return NULL;
+
+	FT_Activate_Size(realFace->size);
+	return realFace->file->face;
 }
 
 void Font::clearFaceCache()
 {
+	std::unique_lock<std::mutex> lock(sFreeTypeMutex);
 	mFaceCache.clear();
 }
 
-Font::Glyph* Font::getGlyph(unsigned int id)
+// text is mostly ASCII, don't go through the full UTF-8 decoder for it
+static inline unsigned int decodeChar(const std::string& text, size_t& cursor)
+{
+	const unsigned char c = (unsigned char)text[cursor];
+	if(c < 0x80)
+	{
+		++cursor;
+		return c;
+	}
+
+	return Utils::String::chars2Unicode(text, cursor);
+}
+
+static inline size_t hashGlyphId(unsigned int id, size_t mask)
+{
+	// Knuth's multiplicative hash, codepoints tend to be clustered so this spreads them out nicely
+	return (size_t)(id * 2654435761u) & mask;
+}
+
+inline Font::Glyph* Font::findGlyph(unsigned int id)
+{
+	if(id < GLYPH_DIRECT_COUNT)
+	{
+		const int index = mGlyphDirect[id];
+		return index != GLYPH_NONE ? &mGlyphs[index] : NULL;
+	}
+
+	const size_t mask = mGlyphHash.size() - 1;
+	for(size_t i = hashGlyphId(id, mask); ; i = (i + 1) & mask)
+	{
+		const GlyphSlot& slot = mGlyphHash[i];
+
+		if(slot.index == GLYPH_NONE)
+			return NULL;
+
+		if(slot.id == id)
+			return &mGlyphs[slot.index];
+	}
+}
+
+void Font::growGlyphHash()
+{
+	std::vector<GlyphSlot> oldHash;
+	oldHash.swap(mGlyphHash);
+	mGlyphHash.assign(oldHash.size() * 2, { 0, GLYPH_NONE });
+
+	const size_t mask = mGlyphHash.size() - 1;
+	for(auto it = oldHash.cbegin(); it != oldHash.cend(); it++)
+	{
+		if(it->index == GLYPH_NONE)
+			continue;
+
+		size_t i = hashGlyphId(it->id, mask);
+		while(mGlyphHash[i].index != GLYPH_NONE)
+			i = (i + 1) & mask;
+
+		mGlyphHash[i] = *it;
+	}
+}
+
+Font::Glyph& Font::insertGlyph(unsigned int id)
+{
+	const int index = (int)mGlyphs.size();
+	mGlyphs.push_back(Glyph());
+	mGlyphs.back().id = id;
+
+	if(id < GLYPH_DIRECT_COUNT)
+	{
+		mGlyphDirect[id] = index;
+		return mGlyphs.back();
+	}
+
+	// keep the load factor at or below 50% so probe sequences stay short
+	if((mGlyphHashCount + 1) * 2 > mGlyphHash.size())
+		growGlyphHash();
+
+	const size_t mask = mGlyphHash.size() - 1;
+	size_t i = hashGlyphId(id, mask);
+	while(mGlyphHash[i].index != GLYPH_NONE)
+		i = (i + 1) & mask;
+
+	mGlyphHash[i] = { id, index };
+	mGlyphHashCount++;
+
+	return mGlyphs.back();
+}
+
+Font::Glyph* Font::getGlyph(unsigned int id, bool async)
 {
 	// is it already loaded?
-	auto it = mGlyphMap.find(id);
-	if(it != mGlyphMap.cend())
-		return &it->second;
+	Glyph* found = findGlyph(id);
+	if(found)
+	{
+		// can't wait for the worker
+		if(found->pending && !async)
+		{
+			Vector2i size;
+			std::vector<unsigned char> bitmap;
+			if(!rasterizeGlyph(id, size, bitmap))
+				size = Vector2i::Zero();
+
+			finishGlyph(*found, size, bitmap);
+		}
+
+		return found;
+	}
 
 	// nope, need to make a glyph
+	if(async)
+	{
+		// only the metrics are needed right away (for layout), the bitmap is left to the worker
+		Vector2f advance;
+		Vector2f bearing;
+		if(!loadGlyphMetrics(id, advance, bearing))
+			return NULL;
+
+		Glyph* glyph = addGlyph(id, Vector2i::Zero(), NULL, 0, advance, bearing);
+		glyph->pending = true;
+
+		sRasterizer.request(this, id);
+		return glyph;
+	}
+
+	Vector2i size;
+	std::vector<unsigned char> bitmap;
+	Vector2f advance;
+	Vector2f bearing;
+	if(!rasterizeGlyph(id, size, bitmap, &advance, &bearing))
+		return NULL;
+
+	mGlyphCacheDirty = true;
+
+	return addGlyph(id, size, bitmap.data(), size.x(), advance, bearing);
+}
+
+bool Font::loadGlyphMetrics(unsigned int id, Vector2f& advance_out, Vector2f& bearing_out)
+{
+	std::unique_lock<std::mutex> lock(sFreeTypeMutex);
+
 	FT_Face face = getFaceForChar(id);
 	if(!face)
 	{
 		LOG(LogError) << "Could not find appropriate font face for character " << id << " for font " << mPath;
-		return NULL;
+		return false;
+	}
+
+	// loading without rendering still gives the same (hinted) metrics
+	if(FT_Load_Char(face, id, FT_LOAD_DEFAULT))
+	{
+		LOG(LogError) << "Could not find glyph for character " << id << " for font " << mPath << ", size " << mSize << "!";
+		return false;
+	}
+
+	FT_GlyphSlot g = face->glyph;
+	advance_out = Vector2f((float)g->metrics.horiAdvance / 64.0f, (float)g->metrics.vertAdvance / 64.0f);
+	bearing_out = Vector2f((float)g->metrics.horiBearingX / 64.0f, (float)g->metrics.horiBearingY / 64.0f);
+
+	return true;
+}
+
+bool Font::rasterizeGlyph(unsigned int id, Vector2i& size_out, std::vector<unsigned char>& bitmap_out, Vector2f* advance_out, Vector2f* bearing_out)
+{
+	std::unique_lock<std::mutex> lock(sFreeTypeMutex);
+
+	FT_Face face = getFaceForChar(id);
+	if(!face)
+	{
+		LOG(LogError) << "Could not find appropriate font face for character " << id << " for font " << mPath;
+		return false;
 	}
 
 	FT_GlyphSlot g = face->glyph;
@@ -319,34 +504,79 @@ Font::Glyph* Font::getGlyph(unsigned int id)
 	if(FT_Load_Char(face, id, FT_LOAD_RENDER))
 	{
 		LOG(LogError) << "Could not find glyph for character " << id << " for font " << mPath << ", size " << mSize << "!";
-		return NULL;
+		return false;
 	}
 
-	Vector2i glyphSize(g->bitmap.width, g->bitmap.rows);
+	size_out = Vector2i(g->bitmap.width, g->bitmap.rows);
+	bitmap_out.resize(size_out.x() * size_out.y());
+	for(int y = 0; y < size_out.y(); y++)
+		memcpy(&bitmap_out[y * size_out.x()], g->bitmap.buffer + y * g->bitmap.pitch, size_out.x());
 
-	FontTexture* tex = NULL;
-	Vector2i cursor;
-	getTextureForNewGlyph(glyphSize, tex, cursor);
+	if(advance_out)
+		*advance_out = Vector2f((float)g->metrics.horiAdvance / 64.0f, (float)g->metrics.vertAdvance / 64.0f);
+
+	if(bearing_out)
+		*bearing_out = Vector2f((float)g->metrics.horiBearingX / 64.0f, (float)g->metrics.horiBearingY / 64.0f);
+
+	return true;
+}
 
-	// getTextureForNewGlyph can fail if the glyph is bigger than the max texture size (absurdly large font size)
-	if(tex == NULL)
+void Font::finishGlyph(Glyph& glyph, const Vector2i& size, const std::vector<unsigned char>& bitmap)
+{
+	glyph.bitmapOffset = mGlyphBitmaps.size();
+	glyph.bitmapSize = size;
+	glyph.pending = false;
+	mGlyphBitmaps.insert(mGlyphBitmaps.end(), bitmap.cbegin(), bitmap.cend());
+
+	// same as addGlyph, the height only counts once the bitmap is there
+	if(size.y() > mMaxGlyphHeight)
+		mMaxGlyphHeight = size.y();
+
+	// caches built while the glyph was missing get rebuilt
+	mGlyphArrivals++;
+	mGlyphCacheDirty = true;
+}
+
+void Font::processRasterizedGlyphs()
+{
+	static std::vector<GlyphRasterizer::Result> results;
+	sRasterizer.collect(results);
+
+	// fonts cancel their requests when they're destroyed, so everything here is still alive
+	for(auto it = results.cbegin(); it != results.cend(); it++)
 	{
-		LOG(LogError) << "Could not create glyph for character " << id << " for font " << mPath << ", size " << mSize << " (no suitable texture found)!";
-		return NULL;
+		Glyph* glyph = it->font->findGlyph(it->id);
+		if(glyph == NULL || !glyph->pending)
+			continue;
+
+		it->font->finishGlyph(*glyph, it->ok ? it->size : Vector2i::Zero(), it->bitmap);
 	}
 
-	// create glyph
-	Glyph& glyph = mGlyphMap[id];
+	results.clear();
+}
+
+Font::Glyph* Font::addGlyph(unsigned int id, const Vector2i& glyphSize, const unsigned char* bitmap, int pitch, const Vector2f& advance, const Vector2f& bearing)
+{
+	// keep a tightly packed copy of the bitmap
+	const size_t bitmapOffset = mGlyphBitmaps.size();
+	mGlyphBitmaps.resize(bitmapOffset + glyphSize.x() * glyphSize.y());
+	for(int y = 0; y < glyphSize.y(); y++)
+		memcpy(&mGlyphBitmaps[bitmapOffset + y * glyphSize.x()], bitmap + y * pitch, glyphSize.x());
+
+	// create glyph, it only gets a spot in the atlas once it's actually drawn
+	Glyph& glyph = insertGlyph(id);
 
-	glyph.texture = tex;
-	glyph.texPos = Vector2f(cursor.x() / (float)tex->textureSize.x(), cursor.y() / (float)tex->textureSize.y());
-	glyph.texSize = Vector2f(glyphSize.x() / (float)tex->textureSize.x(), glyphSize.y() / (float)tex->textureSize.y());
+	glyph.pending = false;
+	glyph.page = NULL;
+	glyph.generation = 0;
+	glyph.texPos = Vector2f::Zero();
+	glyph.texSize = Vector2f::Zero();
 
-	glyph.advance = Vector2f((float)g->metrics.horiAdvance / 64.0f, (float)g->metrics.vertAdvance / 64.0f);
-	glyph.bearing = Vector2f((float)g->metrics.horiBearingX / 64.0f, (float)g->metrics.horiBearingY / 64.0f);
+	glyph.advance = advance;
+	glyph.bearing = bearing;
 
-	// upload glyph bitmap to texture
-	Renderer::updateTexture(tex->textureId, Renderer::Texture::ALPHA, cursor.x(), cursor.y(), glyphSize.x(), glyphSize.y(), g->bitmap.buffer);
+	glyph.bitmapOffset = bitmapOffset;
+	glyph.bitmapSize = glyphSize;
 
 	// update max glyph height
 	if(glyphSize.y() > mMaxGlyphHeight)
@@ -356,32 +586,207 @@ Font::Glyph* Font::getGlyph(unsigned int id)
 	return &glyph;
 }
 
-// completely recreate the texture data for all textures based on mGlyphs information
-void Font::rebuildTextures()
+bool Font::placeGlyph(Glyph& glyph)
 {
-	// recreate OpenGL textures
-	for(auto it = mTextures.begin(); it != mTextures.end(); it++)
+	Vector2i cursor;
+	GlyphAtlas::Page* page = GlyphAtlas::getInstance()->add(glyph.bitmapSize, &mGlyphBitmaps[glyph.bitmapOffset], cursor);
+
+	// this can fail if the glyph is bigger than an atlas page (absurdly large font size)
+	if(page == NULL)
 	{
-		it->initTexture();
+		LOG(LogError) << "Could not place glyph for character " << glyph.id << " for font " << mPath << ", size " << mSize << " in the glyph atlas!";
+		return false;
 	}
 
-	// reupload the texture data
-	for(auto it = mGlyphMap.cbegin(); it != mGlyphMap.cend(); it++)
+	glyph.page = page;
+	glyph.generation = page->generation;
+	glyph.texPos = Vector2f(cursor.x() / (float)GlyphAtlas::PAGE_SIZE, cursor.y() / (float)GlyphAtlas::PAGE_SIZE);
+	glyph.texSize = Vector2f(glyph.bitmapSize.x() / (float)GlyphAtlas::PAGE_SIZE, glyph.bitmapSize.y() / (float)GlyphAtlas::PAGE_SIZE);
+
+	return true;
+}
+
+// glyph caches are keyed by a hash of the font file and the size and modification time of the fallback fonts, so updating
+// any of them (or installing a fallback font) simply misses the cache
+#define GLYPH_CACHE_MAGIC   0x43475345 // "ESGC"
+#define GLYPH_CACHE_VERSION 1
+
+struct GlyphCacheHeader
+{
+	unsigned int       magic;
+	unsigned int       version;
+	unsigned long long hash;
+	int                size;
+	unsigned int       glyphCount;
+	unsigned int       bitmapSize;
+};
+
+struct GlyphCacheRecord
+{
+	unsigned int id;
+	int          width;
+	int          height;
+	float        advanceX;
+	float        advanceY;
+	float        bearingX;
+	float        bearingY;
+	unsigned int bitmapOffset;
+};
+
+static void hashBytes(unsigned long long& hash, const unsigned char* data, size_t length)
+{
+	// 64-bit FNV-1a
+	for(size_t i = 0; i < length; i++)
 	{
-		FT_Face face = getFaceForChar(it->first);
-		FT_GlyphSlot glyphSlot = face->glyph;
+		hash ^= data[i];
+		hash *= 1099511628211ull;
+	}
+}
 
-		// load the glyph bitmap through FT
-		FT_Load_Char(face, it->first, FT_LOAD_RENDER);
+unsigned long long Font::hashFontFiles(FontFile& file)
+{
+	static const std::vector<std::string> fallbackFonts = getFallbackFontPaths();
+
+	// sFreeTypeMutex must be held, the file is shared between fonts
+	if(!file.hashed)
+	{
+		file.hash = 14695981039346656037ull;
+		hashBytes(file.hash, file.data, file.length);
+		file.hashed = true;
+	}
+
+	unsigned long long hash = file.hash;
+
+	// glyphs missing from the font come from the fallback fonts, so which ones are installed matters too and so does
+	// updating one, those are big and mostly never opened so their size and modification time stand in for their contents
+	for(auto it = fallbackFonts.cbegin(); it != fallbackFonts.cend(); it++)
+	{
+		const long long stamp[2] = { Utils::FileSystem::getFileSize(*it), Utils::FileSystem::getModifiedTime(*it) };
+		hashBytes(hash, (const unsigned char*)it->c_str(), it->size() + 1);
+		hashBytes(hash, (const unsigned char*)stamp, sizeof(stamp));
+	}
+
+	return hash;
+}
+
+std::string Font::getGlyphCachePath() const
+{
+	char name[64];
+	snprintf(name, sizeof(name), "%016llx_%d.glyphs", mGlyphCacheHash, mSize);
+	return Utils::FileSystem::getHomePath() + "/.emulationstation/cache/fonts/" + name;
+}
+
+bool Font::loadGlyphCache()
+{
+	const std::string path = getGlyphCachePath();
+	if(!Utils::FileSystem::exists(path))
+		return false;
+
+	std::ifstream stream(path, std::ios::binary | std::ios::ate);
+	const unsigned long long fileSize = (unsigned long long)stream.tellg();
+	stream.seekg(0, std::ios::beg);
+
+	// the counts come from disk, make sure the file actually holds that much before allocating for it
+	GlyphCacheHeader header;
+	if(!stream.read((char*)&header, sizeof(header)) ||
+		header.magic != GLYPH_CACHE_MAGIC || header.version != GLYPH_CACHE_VERSION ||
+		header.hash != mGlyphCacheHash || header.size != mSize ||
+		sizeof(header) + (unsigned long long)header.glyphCount * sizeof(GlyphCacheRecord) + header.bitmapSize != fileSize)
+	{
+		LOG(LogWarning) << "Ignoring invalid glyph cache " << path;
+		return false;
+	}
+
+	std::vector<GlyphCacheRecord> records(header.glyphCount);
+	std::vector<unsigned char> bitmaps(header.bitmapSize);
+	if((header.glyphCount && !stream.read((char*)&records[0], header.glyphCount * sizeof(GlyphCacheRecord))) ||
+		(header.bitmapSize && !stream.read((char*)&bitmaps[0], header.bitmapSize)))
+	{
+		LOG(LogWarning) << "Ignoring truncated glyph cache " << path;
+		return false;
+	}
+
+	mGlyphBitmaps.reserve(header.bitmapSize);
+
+	for(auto it = records.cbegin(); it != records.cend(); it++)
+	{
+		if(it->width < 0 || it->height < 0 || (size_t)it->bitmapOffset + (size_t)it->width * it->height > bitmaps.size())
+		{
+			LOG(LogWarning) << "Glyph cache " << path << " is corrupt, ignoring the rest of it";
+			mGlyphCacheDirty = true;
+			break;
+		}
+
+		if(findGlyph(it->id))
+			continue;
+
+		addGlyph(it->id, Vector2i(it->width, it->height), bitmaps.data() + it->bitmapOffset, it->width,
+			Vector2f(it->advanceX, it->advanceY), Vector2f(it->bearingX, it->bearingY));
+	}
+
+	return true;
+}
+
+void Font::saveGlyphCache()
+{
+	const std::string path = getGlyphCachePath();
+	Utils::FileSystem::createDirectory(Utils::FileSystem::getParent(path));
+
+	std::ofstream stream(path, std::ios::binary | std::ios::trunc);
+	if(!stream.is_open())
+	{
+		LOG(LogError) << "Could not write glyph cache " << path;
+		return;
+	}
+
+	GlyphCacheHeader header;
+	header.magic = GLYPH_CACHE_MAGIC;
+	header.version = GLYPH_CACHE_VERSION;
+	header.hash = mGlyphCacheHash;
+	header.size = mSize;
+	header.glyphCount = 0;
+	for(auto it = mGlyphs.cbegin(); it != mGlyphs.cend(); it++)
+		header.glyphCount += it->pending ? 0 : 1;
+	header.bitmapSize = (unsigned int)mGlyphBitmaps.size();
+	stream.write((const char*)&header, sizeof(header));
+
+	for(auto it = mGlyphs.cbegin(); it != mGlyphs.cend(); it++)
+	{
+		if(it->pending)
+			continue;
+
+		GlyphCacheRecord record = { it->id, it->bitmapSize.x(), it->bitmapSize.y(), it->advance.x(), it->advance.y(), it->bearing.x(), it->bearing.y(), (unsigned int)it->bitmapOffset };
+		stream.write((const char*)&record, sizeof(record));
+	}
+
+	if(!mGlyphBitmaps.empty())
+		stream.write((const char*)&mGlyphBitmaps[0], mGlyphBitmaps.size());
+
+	if(stream.fail())
+		LOG(LogError) << "Error writing glyph cache " << path;
+	else
+		mGlyphCacheDirty = false;
+}
+
+void Font::prewarmGlyphs()
+{
+	// Latin-1 supplement plus the typographic punctuation scrapers tend to bring in, on top of the ASCII every font loads
+	static const unsigned int punctuation[] = { 0x2013, 0x2014, 0x2018, 0x2019, 0x201C, 0x201D, 0x2022, 0x2026, 0x2122 };
+
+	for(auto it = sFontMap.cbegin(); it != sFontMap.cend(); it++)
+	{
+		std::shared_ptr<Font> font = it->second.lock();
+		if(!font)
+			continue;
 
-		FontTexture* tex = it->second.texture;
+		for(unsigned int id = 0xA0; id < 0x100; id++)
+			font->getGlyph(id, false);
 
-		// find the position/size
-		Vector2i cursor((int)(it->second.texPos.x() * tex->textureSize.x()), (int)(it->second.texPos.y() * tex->textureSize.y()));
-		Vector2i glyphSize((int)(it->second.texSize.x() * tex->textureSize.x()), (int)(it->second.texSize.y() * tex->textureSize.y()));
+		for(unsigned int i = 0; i < sizeof(punctuation) / sizeof(punctuation[0]); i++)
+			font->getGlyph(punctuation[i], false);
 
-		// upload to texture
-		Renderer::updateTexture(tex->textureId, Renderer::Texture::ALPHA, cursor.x(), cursor.y(), glyphSize.x(), glyphSize.y(), glyphSlot->bitmap.buffer);
+		if(font->mGlyphCacheDirty)
+			font->saveGlyphCache();
 	}
 }
 
@@ -393,17 +798,48 @@ void Font::renderTextCache(TextCache* cache)
 		return;
 	}
 
+	refreshTextCache(cache);
+
 	for(auto it = cache->vertexLists.cbegin(); it != cache->vertexLists.cend(); it++)
 	{
-		assert(*it->textureIdPtr != 0);
-
-		auto vertexList = *it;
+		assert(it->page->textureId != 0);
 
-		Renderer::bindTexture(*it->textureIdPtr);
+		Renderer::bindTexture(it->page->textureId);
 		Renderer::drawTriangleStrips(&it->verts[0], it->verts.size());
 	}
 }
 
+void Font::refreshTextCache(TextCache* cache)
+{
+	GlyphAtlas* atlas = GlyphAtlas::getInstance().get();
+
+	bool stale = cache->incomplete && cache->glyphArrivals != mGlyphArrivals;
+	for(auto it = cache->vertexLists.cbegin(); !stale && it != cache->vertexLists.cend(); it++)
+	{
+		if(!atlas->isValid(it->page, it->generation))
+		{
+			stale = true;
+			break;
+		}
+	}
+
+	// some of the glyphs were evicted from the atlas (or the renderer was reinitialized), lay the vertices out again
+	// the layout and metrics don't change so this is invisible to whoever holds the cache, even a shared one
+	if(stale)
+	{
+		std::unique_ptr<TextCache> rebuilt(buildTextCache(cache->text, cache->layout, cache->offset, cache->color, cache->xLen, cache->alignment, cache->lineSpacing));
+		cache->vertexLists.swap(rebuilt->vertexLists);
+		cache->incomplete = rebuilt->incomplete;
+		cache->glyphArrivals = rebuilt->glyphArrivals;
+	}
+
+	for(auto it = cache->vertexLists.cbegin(); it != cache->vertexLists.cend(); it++)
+		atlas->touch(it->page);
+
+	// upload whatever glyphs were placed since the last draw
+	atlas->flush();
+}
+
 Vector2f Font::sizeText(std::string text, float lineSpacing)
 {
 	float lineWidth = 0.0f;
@@ -416,7 +852,7 @@ Vector2f Font::sizeText(std::string text, float lineSpacing)
 	size_t i = 0;
 	while(i < text.length())
 	{
-		unsigned int character = Utils::String::chars2Unicode(text, i); // advances i
+		unsigned int character = decodeChar(text, i); // advances i
 
 		if(character == '\n')
 		{
@@ -445,119 +881,149 @@ float Font::getHeight(float lineSpacing) const
 
 float Font::getLetterHeight()
 {
-	Glyph* glyph = getGlyph('S');
+	Glyph* glyph = getGlyph('S', false);
 	assert(glyph);
-	return glyph->texSize.y() * glyph->texture->textureSize.y();
+	return (float)glyph->bitmapSize.y();
 }
 
-//the worst algorithm ever written
-//breaks up a normal string with newlines to make it fit xLen
-std::string Font::wrapText(std::string text, float xLen)
+// breaks text into lines in a single pass, accumulating glyph advances as it goes
+// a line is broken after the last whitespace that still fits xLen, words that are longer than xLen are left to overflow
+void Font::layoutText(const std::string& text, float xLen, TextLayout& layout)
 {
-	std::string out;
+	layout.lines.clear();
+	layout.width = 0.0f;
 
-	std::string line, word, temp;
-	size_t space;
+	size_t lineStart  = 0;
+	float  lineWidth  = 0.0f;
+	size_t breakPos   = 0;
+	float  breakWidth = 0.0f;
+	bool   canBreak   = false;
 
-	Vector2f textSize;
-
-	while(text.length() > 0) //while there's text or we still have text to render
+	size_t cursor = 0;
+	while(cursor < text.length())
 	{
-		space = text.find_first_of(" \t\n");
-		if(space == std::string::npos)
-			space = text.length() - 1;
+		const size_t       charStart = cursor;
+		const unsigned int character = decodeChar(text, cursor); // advances cursor
 
-		word = text.substr(0, space + 1);
-		text.erase(0, space + 1);
+		if(character == '\n')
+		{
+			layout.lines.push_back({ lineStart, charStart, lineWidth });
+			if(lineWidth > layout.width)
+				layout.width = lineWidth;
 
-		temp = line + word;
+			lineStart = cursor;
+			lineWidth = 0.0f;
+			canBreak  = false;
+			continue;
+		}
 
-		textSize = sizeText(temp);
+		Glyph* glyph = getGlyph(character);
+		if(glyph)
+			lineWidth += glyph->advance.x();
 
-		// if the word will fit on the line, add it to our line, and continue
-		if(textSize.x() <= xLen)
+		// this character doesn't fit anymore, break the line after the last whitespace
+		if(xLen > 0.0f && lineWidth > xLen && canBreak)
 		{
-			line = temp;
-			continue;
-		}else{
-			// the next word won't fit, so break here
-			out += line + '\n';
-			line = word;
+			layout.lines.push_back({ lineStart, breakPos, breakWidth });
+			if(breakWidth > layout.width)
+				layout.width = breakWidth;
+
+			lineStart  = breakPos;
+			lineWidth -= breakWidth;
+			canBreak   = false;
 		}
-	}
 
-	// whatever's left should fit
-	out += line;
+		if(character == ' ' || character == '\t')
+		{
+			breakPos   = cursor;
+			breakWidth = lineWidth;
+			canBreak   = true;
+		}
+	}
 
-	return out;
+	layout.lines.push_back({ lineStart, text.length(), lineWidth });
+	if(lineWidth > layout.width)
+		layout.width = lineWidth;
 }
 
-Vector2f Font::sizeWrappedText(std::string text, float xLen, float lineSpacing)
+Vector2f Font::sizeLayout(const TextLayout& layout, float lineSpacing) const
 {
-	text = wrapText(text, xLen);
-	return sizeText(text, lineSpacing);
+	return Vector2f(layout.width, layout.lines.size() * getHeight(lineSpacing));
 }
 
-Vector2f Font::getWrappedTextCursorOffset(std::string text, float xLen, size_t stop, float lineSpacing)
+Vector2f Font::getLayoutCursorOffset(const std::string& text, const TextLayout& layout, size_t stop, float lineSpacing)
 {
-	std::string wrappedText = wrapText(text, xLen);
+	if(layout.lines.empty())
+		return Vector2f(0.0f, 0.0f);
+
+	// find the line the cursor is on, a cursor sitting on a wrap point stays at the end of the previous line
+	size_t line = 0;
+	while(line + 1 < layout.lines.size() && stop > layout.lines[line].end)
+		line++;
 
 	float lineWidth = 0.0f;
-	float y = 0.0f;
 
-	size_t wrapCursor = 0;
-	size_t cursor = 0;
-	while(cursor < stop)
+	size_t cursor = layout.lines[line].start;
+	while(cursor < stop && cursor < layout.lines[line].end)
 	{
-		unsigned int wrappedCharacter = Utils::String::chars2Unicode(wrappedText, wrapCursor);
-		unsigned int character = Utils::String::chars2Unicode(text, cursor);
-
-		if(wrappedCharacter == '\n' && character != '\n')
-		{
-			//this is where the wordwrap inserted a newline
-			//reset lineWidth and increment y, but don't consume a cursor character
-			lineWidth = 0.0f;
-			y += getHeight(lineSpacing);
-
-			cursor = Utils::String::prevCursor(text, cursor); // unconsume
-			continue;
-		}
-
-		if(character == '\n')
-		{
-			lineWidth = 0.0f;
-			y += getHeight(lineSpacing);
-			continue;
-		}
+		unsigned int character = decodeChar(text, cursor); // advances cursor
 
 		Glyph* glyph = getGlyph(character);
 		if(glyph)
 			lineWidth += glyph->advance.x();
 	}
 
-	return Vector2f(lineWidth, y);
+	return Vector2f(lineWidth, line * getHeight(lineSpacing));
+}
+
+//breaks up a normal string with newlines to make it fit xLen
+std::string Font::wrapText(std::string text, float xLen)
+{
+	TextLayout layout;
+	layoutText(text, xLen, layout);
+
+	std::string out;
+	out.reserve(text.length() + layout.lines.size());
+
+	for(auto it = layout.lines.cbegin(); it != layout.lines.cend(); it++)
+	{
+		if(it != layout.lines.cbegin())
+			out += '\n';
+
+		out.append(text, it->start, it->end - it->start);
+	}
+
+	return out;
+}
+
+Vector2f Font::sizeWrappedText(std::string text, float xLen, float lineSpacing)
+{
+	TextLayout layout;
+	layoutText(text, xLen, layout);
+	return sizeLayout(layout, lineSpacing);
+}
+
+Vector2f Font::getWrappedTextCursorOffset(std::string text, float xLen, size_t stop, float lineSpacing)
+{
+	TextLayout layout;
+	layoutText(text, xLen, layout);
+	return getLayoutCursorOffset(text, layout, stop, lineSpacing);
 }
 
 //=============================================================================================================
 //TextCache
 //=============================================================================================================
 
-float Font::getNewlineStartOffset(const std::string& text, const unsigned int& charStart, const float& xLen, const Alignment& alignment)
+float Font::getLineStartOffset(const float& lineWidth, const float& xLen, const Alignment& alignment)
 {
 	switch(alignment)
 	{
 	case ALIGN_LEFT:
 		return 0;
 	case ALIGN_CENTER:
-		{
-			unsigned int endChar = (unsigned int)text.find('\n', charStart);
-			return (xLen - sizeText(text.substr(charStart, endChar != std::string::npos ? endChar - charStart : endChar)).x()) / 2.0f;
-		}
+		return (xLen - lineWidth) / 2.0f;
 	case ALIGN_RIGHT:
-		{
-			unsigned int endChar = (unsigned int)text.find('\n', charStart);
-			return xLen - (sizeText(text.substr(charStart, endChar != std::string::npos ? endChar - charStart : endChar)).x());
-		}
+		return xLen - lineWidth;
 	default:
 		return 0;
 	}
@@ -565,79 +1031,113 @@ float Font::getNewlineStartOffset(const std::string& text, const unsigned int& c
 
 TextCache* Font::buildTextCache(const std::string& text, Vector2f offset, unsigned int color, float xLen, Alignment alignment, float lineSpacing)
 {
-	float x = offset[0] + (xLen != 0 ? getNewlineStartOffset(text, 0, xLen, alignment) : 0);
+	// only break lines at newlines, the text is expected to be wrapped already
+	TextLayout layout;
+	layoutText(text, 0.0f, layout);
+	return buildTextCache(text, layout, offset, color, xLen, alignment, lineSpacing);
+}
+
+TextCache* Font::buildTextCache(const std::string& text, const TextLayout& layout, Vector2f offset, unsigned int color, float xLen, Alignment alignment, float lineSpacing)
+{
+	Renderer::countTextCacheBuilt();
 
 	float yTop = getGlyph('S')->bearing.y();
 	float yBot = getHeight(lineSpacing);
 	float y = offset[1] + (yBot + yTop)/2.0f;
 
-	// vertices by texture
-	std::map< FontTexture*, std::vector<Renderer::Vertex> > vertMap;
+	const unsigned int convertedColor = Renderer::convertColor(color);
 
-	size_t cursor = 0;
-	while(cursor < text.length())
-	{
-		unsigned int character = Utils::String::chars2Unicode(text, cursor); // also advances cursor
-		Glyph* glyph;
+	GlyphAtlas* atlas = GlyphAtlas::getInstance().get();
 
-		// invalid character
-		if(character == 0)
-			continue;
+	// vertices by atlas page
+	std::map< GlyphAtlas::Page*, std::vector<Renderer::Vertex> > vertMap;
+	bool incomplete = false;
 
-		if(character == '\n')
+	for(auto line = layout.lines.cbegin(); line != layout.lines.cend(); line++)
+	{
+		float x = offset[0] + (xLen != 0 ? getLineStartOffset(line->width, xLen, alignment) : 0);
+
+		size_t cursor = line->start;
+		while(cursor < line->end)
 		{
-			y += getHeight(lineSpacing);
-			x = offset[0] + (xLen != 0 ? getNewlineStartOffset(text, (const unsigned int)cursor /* cursor is already advanced */, xLen, alignment) : 0);
-			continue;
+			unsigned int character = decodeChar(text, cursor); // also advances cursor
+			Glyph* glyph;
+
+			// invalid character
+			if(character == 0)
+				continue;
+
+			glyph = getGlyph(character);
+			if(glyph == NULL)
+				continue;
+
+			// nothing to draw for whitespace, and the worker might not be done with the glyph yet
+			if(glyph->pending || glyph->bitmapSize.x() <= 0 || glyph->bitmapSize.y() <= 0)
+			{
+				incomplete |= glyph->pending;
+				x += glyph->advance.x();
+				continue;
+			}
+
+			// glyphs get their spot in the atlas the first time they're drawn, or again if their page was evicted
+			if(!atlas->isValid(glyph->page, glyph->generation) && !placeGlyph(*glyph))
+				continue;
+
+			// a page used by this cache can't be evicted while the rest of it is being built
+			atlas->touch(glyph->page);
+
+			std::vector<Renderer::Vertex>& verts = vertMap[glyph->page];
+			size_t oldVertSize = verts.size();
+			verts.resize(oldVertSize + 6);
+			Renderer::Vertex* vertices = verts.data() + oldVertSize;
+
+			const float    glyphStartX = x + glyph->bearing.x();
+			const Vector2i textureSize(GlyphAtlas::PAGE_SIZE, GlyphAtlas::PAGE_SIZE);
+
+			vertices[1] = { { glyphStartX                                       , y - glyph->bearing.y()                                          }, { glyph->texPos.x(),                      glyph->texPos.y()                      }, convertedColor };
+			vertices[2] = { { glyphStartX                                       , y - glyph->bearing.y() + (glyph->texSize.y() * textureSize.y()) }, { glyph->texPos.x(),                      glyph->texPos.y() + glyph->texSize.y() }, convertedColor };
+			vertices[3] = { { glyphStartX + glyph->texSize.x() * textureSize.x(), y - glyph->bearing.y()                                          }, { glyph->texPos.x() + glyph->texSize.x(), glyph->texPos.y()                      }, convertedColor };
+			vertices[4] = { { glyphStartX + glyph->texSize.x() * textureSize.x(), y - glyph->bearing.y() + (glyph->texSize.y() * textureSize.y()) }, { glyph->texPos.x() + glyph->texSize.x(), glyph->texPos.y() + glyph->texSize.y() }, convertedColor };
+
+			// round vertices
+			for(int i = 1; i < 5; ++i)
+				vertices[i].pos.round();
+
+			// make duplicates of first and last vertex so this can be rendered as a triangle strip
+			vertices[0] = vertices[1];
+			vertices[5] = vertices[4];
+
+			// advance
+			x += glyph->advance.x();
 		}
 
-		glyph = getGlyph(character);
-		if(glyph == NULL)
-			continue;
-
-		std::vector<Renderer::Vertex>& verts = vertMap[glyph->texture];
-		size_t oldVertSize = verts.size();
-		verts.resize(oldVertSize + 6);
-		Renderer::Vertex* vertices = verts.data() + oldVertSize;
-
-		const float        glyphStartX    = x + glyph->bearing.x();
-		const Vector2i&    textureSize    = glyph->texture->textureSize;
-		const unsigned int convertedColor = Renderer::convertColor(color);
-
-		vertices[1] = { { glyphStartX                                       , y - glyph->bearing.y()                                          }, { glyph->texPos.x(),                      glyph->texPos.y()                      }, convertedColor };
-		vertices[2] = { { glyphStartX                                       , y - glyph->bearing.y() + (glyph->texSize.y() * textureSize.y()) }, { glyph->texPos.x(),                      glyph->texPos.y() + glyph->texSize.y() }, convertedColor };
-		vertices[3] = { { glyphStartX + glyph->texSize.x() * textureSize.x(), y - glyph->bearing.y()                                          }, { glyph->texPos.x() + glyph->texSize.x(), glyph->texPos.y()                      }, convertedColor };
-		vertices[4] = { { glyphStartX + glyph->texSize.x() * textureSize.x(), y - glyph->bearing.y() + (glyph->texSize.y() * textureSize.y()) }, { glyph->texPos.x() + glyph->texSize.x(), glyph->texPos.y() + glyph->texSize.y() }, convertedColor };
-
-		// round vertices
-		for(int i = 1; i < 5; ++i)
-			vertices[i].pos.round();
-
-		// make duplicates of first and last vertex so this can be rendered as a triangle strip
-		vertices[0] = vertices[1];
-		vertices[5] = vertices[4];
-
-		// advance
-		x += glyph->advance.x();
+		y += getHeight(lineSpacing);
 	}
 
-	//TextCache::CacheMetrics metrics = { sizeText(text, lineSpacing) };
-
 	TextCache* cache = new TextCache();
 	cache->vertexLists.resize(vertMap.size());
-	cache->metrics = { sizeText(text, lineSpacing) };
+	cache->metrics = { sizeLayout(layout, lineSpacing) };
+
+	cache->text = text;
+	cache->layout = layout;
+	cache->offset = offset;
+	cache->color = color;
+	cache->xLen = xLen;
+	cache->alignment = alignment;
+	cache->lineSpacing = lineSpacing;
+	cache->incomplete = incomplete;
+	cache->glyphArrivals = mGlyphArrivals;
 
 	unsigned int i = 0;
-	for(auto it = vertMap.cbegin(); it != vertMap.cend(); it++)
+	for(auto it = vertMap.begin(); it != vertMap.end(); it++, i++)
 	{
 		TextCache::VertexList& vertList = cache->vertexLists.at(i);
 
-		vertList.textureIdPtr = &it->first->textureId;
-		vertList.verts = it->second;
+		vertList.page = it->first;
+		vertList.generation = it->first->generation;
+		vertList.verts.swap(it->second);
 	}
 
-	clearFaceCache();
-
 	return cache;
 }
 
@@ -646,15 +1146,118 @@ TextCache* Font::buildTextCache(const std::string& text, float offsetX, float of
 	return buildTextCache(text, Vector2f(offsetX, offsetY), color, 0.0f);
 }
 
-void TextCache::setColor(unsigned int color)
+bool Font::TextCacheKey::operator==(const TextCacheKey& other) const
 {
-	const unsigned int convertedColor = Renderer::convertColor(color);
+	return font == other.font && xLen == other.xLen && alignment == other.alignment && lineSpacing == other.lineSpacing && text == other.text;
+}
+
+size_t Font::TextCacheKeyHash::operator()(const TextCacheKey& key) const
+{
+	size_t hash = std::hash<std::string>()(key.text);
+	hash ^= std::hash<const void*>()(key.font) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+	hash ^= std::hash<float>()(key.xLen) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+	hash ^= std::hash<float>()(key.lineSpacing) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+	hash ^= (size_t)key.alignment + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+	return hash;
+}
+
+std::shared_ptr<TextCache> Font::getTextCache(const std::string& text, float xLen, Alignment alignment, float lineSpacing)
+{
+	TextCacheKey key = { this, text, xLen, alignment, lineSpacing };
+
+	auto it = sTextCacheMap.find(key);
+	if(it != sTextCacheMap.cend())
+	{
+		// move to the front of the LRU
+		sTextCacheLRU.splice(sTextCacheLRU.begin(), sTextCacheLRU, it->second.lruIt);
+		return it->second.cache;
+	}
+
+	TextLayout layout;
+	layoutText(text, xLen, layout);
+
+	std::shared_ptr<TextCache> cache(buildTextCache(text, layout, Vector2f(0, 0), 0xFFFFFFFF, xLen != 0 ? xLen : layout.width, alignment, lineSpacing));
+
+	auto inserted = sTextCacheMap.emplace(std::move(key), TextCacheEntry());
+	TextCacheEntry& entry = inserted.first->second;
+	sTextCacheLRU.push_front(&inserted.first->first);
+	entry.cache = cache;
+	entry.lruIt = sTextCacheLRU.begin();
+	entry.memUsage = cache->getMemUsage() + text.length();
+	sTextCacheMemUsage += entry.memUsage;
+
+	trimTextCaches(TEXT_CACHE_MAX_MEM_USAGE);
+
+	return cache;
+}
+
+void Font::trimTextCaches(size_t maxMemUsage)
+{
+	// caches that are still in use elsewhere stay alive through their shared_ptr, they just stop being shared
+	while(sTextCacheMemUsage > maxMemUsage && !sTextCacheLRU.empty())
+	{
+		auto it = sTextCacheMap.find(*sTextCacheLRU.back());
+		sTextCacheLRU.pop_back();
+		sTextCacheMemUsage -= it->second.memUsage;
+		sTextCacheMap.erase(it);
+	}
+}
+
+void Font::removeTextCaches()
+{
+	for(auto it = sTextCacheMap.begin(); it != sTextCacheMap.end(); )
+	{
+		if(it->first.font == this)
+		{
+			sTextCacheLRU.erase(it->second.lruIt);
+			sTextCacheMemUsage -= it->second.memUsage;
+			it = sTextCacheMap.erase(it);
+		}
+		else
+			it++;
+	}
+}
+
+void Font::renderTextCache(TextCache* cache, unsigned int color)
+{
+	if(cache == NULL)
+	{
+		LOG(LogError) << "Attempted to draw NULL TextCache!";
+		return;
+	}
+
+	refreshTextCache(cache);
+
+	// shared caches can't be modified, the renderer writes the color while it copies the vertices into its batch
+	for(auto it = cache->vertexLists.cbegin(); it != cache->vertexLists.cend(); it++)
+	{
+		assert(it->page->textureId != 0);
+
+		Renderer::bindTexture(it->page->textureId);
+		Renderer::drawTintedTriangleStrips(it->verts.data(), (unsigned int)it->verts.size(), color);
+	}
+}
+
+void TextCache::setColor(unsigned int _color)
+{
+	const unsigned int convertedColor = Renderer::convertColor(_color);
+	color = _color;
 
 	for(auto it = vertexLists.begin(); it != vertexLists.end(); it++)
 		for(auto it2 = it->verts.begin(); it2 != it->verts.end(); it2++)
 			it2->col = convertedColor;
 }
 
+size_t TextCache::getMemUsage() const
+{
+	size_t memUsage = sizeof(TextCache) + text.capacity() + layout.lines.capacity() * sizeof(TextLayout::Line);
+
+	for(auto it = vertexLists.cbegin(); it != vertexLists.cend(); it++)
+		memUsage += sizeof(VertexList) + it->verts.size() * sizeof(Renderer::Vertex);
+
+	return memUsage;
+}
+
 std::shared_ptr<Font> Font::getFromTheme(const ThemeData::ThemeElement* elem, unsigned int properties, const std::shared_ptr<Font>& orig)
 {
 	using namespace ThemeFlags;
@@ -5,13 +5,20 @@
 #include "math/Vector2f.h"
 #include "math/Vector2i.h"
 #include "renderers/Renderer.h"
+#include "resources/GlyphAtlas.h"
+#include "resources/GlyphRasterizer.h"
 #include "resources/ResourceManager.h"
 #include "ThemeData.h"
 #include <ft2build.h>
 #include FT_FREETYPE_H
+#include FT_SIZES_H
+#include <list>
+#include <mutex>
+#include <unordered_map>
 #include <vector>
 
 class TextCache;
+struct TextLayout;
 
 #define FONT_SIZE_MINI ((unsigned int)(0.030f * Math::min((int)Renderer::getScreenHeight(), (int)Renderer::getScreenWidth())))
 #define FONT_SIZE_SMALL ((unsigned int)(0.035f * Math::min((int)Renderer::getScreenHeight(), (int)Renderer::getScreenWidth())))
@@ -44,8 +51,20 @@ public:
 	Vector2f sizeText(std::string text, float lineSpacing = 1.5f); // Returns the expected size of a string when rendered.  Extra spacing is applied to the Y axis.
 	TextCache* buildTextCache(const std::string& text, float offsetX, float offsetY, unsigned int color);
 	TextCache* buildTextCache(const std::string& text, Vector2f offset, unsigned int color, float xLen, Alignment alignment = ALIGN_LEFT, float lineSpacing = 1.5f);
+	TextCache* buildTextCache(const std::string& text, const TextLayout& layout, Vector2f offset, unsigned int color, float xLen, Alignment alignment = ALIGN_LEFT, float lineSpacing = 1.5f);
 	void renderTextCache(TextCache* cache);
 
+	// Returns a TextCache for text laid out within xLen (no wrapping if xLen is 0, aligned to the widest line instead).
+	// These caches are immutable and shared by everything drawing the same text with the same font and layout,
+	// their vertices are white and the color is applied when rendering them through renderTextCache(cache, color).
+	std::shared_ptr<TextCache> getTextCache(const std::string& text, float xLen = 0.0f, Alignment alignment = ALIGN_LEFT, float lineSpacing = 1.5f);
+	void renderTextCache(TextCache* cache, unsigned int color);
+	void refreshTextCache(TextCache* cache); // rebuilds the cache if any of its glyphs were evicted from the atlas, done by renderTextCache
+
+	void layoutText(const std::string& text, float xLen, TextLayout& layout); // Breaks text into lines that fit xLen (no wrapping if xLen <= 0) in a single pass.
+	Vector2f sizeLayout(const TextLayout& layout, float lineSpacing = 1.5f) const; // Returns the size of previously laid out text.
+	Vector2f getLayoutCursorOffset(const std::string& text, const TextLayout& layout, size_t cursor, float lineSpacing = 1.5f); // Returns the position of the cursor (in bytes) within previously laid out text.
+
 	std::string wrapText(std::string text, float xLen); // Inserts newlines into text to make it wrap properly.
 	Vector2f sizeWrappedText(std::string text, float xLen, float lineSpacing = 1.5f); // Returns the expected size of a string after wrapping is applied.
 	Vector2f getWrappedTextCursorOffset(std::string text, float xLen, size_t cursor, float lineSpacing = 1.5f); // Returns the position of of the cursor after moving "cursor" characters.
@@ -63,8 +82,11 @@ public:
 
 	static std::shared_ptr<Font> getFromTheme(const ThemeData::ThemeElement* elem, unsigned int properties, const std::shared_ptr<Font>& orig);
 
-	size_t getMemUsage() const; // returns an approximation of VRAM used by this font's texture (in bytes)
-	static size_t getTotalMemUsage(); // returns an approximation of total VRAM used by font textures (in bytes)
+	size_t getMemUsage() const; // returns an approximation of memory used by this font's glyphs (in bytes)
+	static size_t getTotalMemUsage(); // returns an approximation of total memory used by fonts and the glyph atlas (in bytes)
+
+	static void processRasterizedGlyphs(); // hands glyphs finished by the worker thread to their fonts, call once per frame
+	static void prewarmGlyphs(); // loads the characters commonly found in game names and descriptions into every live font and saves their glyph caches
 
 private:
 	static FT_Library sLibrary;
@@ -72,72 +94,170 @@ private:
 
 	Font(int size, const std::string& path);
 
-	struct FontTexture
+	// bounded LRU of shared text caches, keyed by (font, text, wrap width, alignment, line spacing)
+	struct TextCacheKey
 	{
-		unsigned int textureId;
-		Vector2i textureSize;
+		const Font* font;
+		std::string text;
+		float xLen;
+		Alignment alignment;
+		float lineSpacing;
 
-		Vector2i writePos;
-		int rowHeight;
+		bool operator==(const TextCacheKey& other) const;
+	};
 
-		FontTexture();
-		~FontTexture();
-		bool findEmpty(const Vector2i& size, Vector2i& cursor_out);
+	struct TextCacheKeyHash
+	{
+		size_t operator()(const TextCacheKey& key) const;
+	};
 
-		// you must call initTexture() after creating a FontTexture to get a textureId
-		void initTexture(); // initializes the OpenGL texture according to this FontTexture's settings, updating textureId
-		void deinitTexture(); // deinitializes the OpenGL texture if any exists, is automatically called in the destructor
+	struct TextCacheEntry
+	{
+		std::shared_ptr<TextCache> cache;
+		std::list<const TextCacheKey*>::iterator lruIt;
+		size_t memUsage;
 	};
 
-	struct FontFace
+	static const size_t TEXT_CACHE_MAX_MEM_USAGE = 8 * 1024 * 1024; // bytes of vertex data kept alive by the LRU
+
+	static std::unordered_map<TextCacheKey, TextCacheEntry, TextCacheKeyHash> sTextCacheMap;
+	static std::list<const TextCacheKey*> sTextCacheLRU; // most recently used first
+	static size_t sTextCacheMemUsage;
+
+	static void trimTextCaches(size_t maxMemUsage);
+	void removeTextCaches();
+
+	// The bytes of a font file and the FT_Face opened on them, shared by every size of that font
+	// and by every font using it as a fallback. The file is memory mapped where possible.
+	struct FontFile
 	{
-		const ResourceData data;
+		const unsigned char* data;
+		size_t length;
+		bool mapped;
+		std::shared_ptr<unsigned char> buffer; // holds the data when it couldn't be mapped
 		FT_Face face;
+		unsigned long long hash; // of the data, computed on first use and shared by every size of the font
+		bool hashed;
 
-		FontFace(ResourceData&& d, int size);
-		virtual ~FontFace();
+		FontFile(const std::string& path);
+		virtual ~FontFile();
 	};
 
-	void rebuildTextures();
-	void unloadTextures();
+	static std::map< std::string, std::weak_ptr<FontFile> > sFontFiles;
+	static std::shared_ptr<FontFile> getFontFile(const std::string& path);
 
-	std::vector<FontTexture> mTextures;
+	// A Font's view of a FontFile, FreeType keeps the pixel size in an FT_Size object so each Font only owns one of those.
+	struct FontFace
+	{
+		const std::shared_ptr<FontFile> file;
+		FT_Size size;
 
-	void getTextureForNewGlyph(const Vector2i& glyphSize, FontTexture*& tex_out, Vector2i& cursor_out);
+		FontFace(const std::shared_ptr<FontFile>& f, int pixelSize);
+		virtual ~FontFace();
+	};
 
-	std::map< unsigned int, std::unique_ptr<FontFace> > mFaceCache;
-	FT_Face getFaceForChar(unsigned int id);
+	// FreeType faces are shared between fonts and used by the rasterizer thread, everything touching them
+	// (including sFontFiles and mFaceCache) must hold sFreeTypeMutex
+	static std::mutex sFreeTypeMutex;
+	static GlyphRasterizer sRasterizer;
+
+	std::map< unsigned int, std::unique_ptr<FontFace> > mFaceCache; // fallback faces are only added once a glyph needs them
+	FT_Face getFaceForChar(unsigned int id); // also makes this font's size active on the returned face
 	void clearFaceCache();
 
+	bool loadGlyphMetrics(unsigned int id, Vector2f& advance_out, Vector2f& bearing_out);
+	bool rasterizeGlyph(unsigned int id, Vector2i& size_out, std::vector<unsigned char>& bitmap_out, Vector2f* advance_out = NULL, Vector2f* bearing_out = NULL); // called from the rasterizer thread too
+
 	struct Glyph
 	{
-		FontTexture* texture;
+		unsigned int id;
 
+		// where the glyph currently lives in the GlyphAtlas, no page for empty glyphs
+		GlyphAtlas::Page* page;
+		unsigned int generation;
 		Vector2f texPos;
-		Vector2f texSize; // in texels!
+		Vector2f texSize; // normalized
 
 		Vector2f advance;
 		Vector2f bearing;
+
+		size_t bitmapOffset; // into mGlyphBitmaps
+		Vector2i bitmapSize;
+		bool pending; // the metrics are known but the rasterizer thread hasn't delivered the bitmap yet
 	};
 
-	std::map<unsigned int, Glyph> mGlyphMap;
+	// glyphs are stored contiguously in mGlyphs and looked up either through a direct table (Latin-1)
+	// or through a small open addressing hash table (everything else), both holding indices into mGlyphs
+	static const unsigned int GLYPH_DIRECT_COUNT = 256;
+	static const int          GLYPH_NONE         = -1;
+
+	struct GlyphSlot
+	{
+		unsigned int id;
+		int index;
+	};
 
-	Glyph* getGlyph(unsigned int id);
+	std::vector<Glyph> mGlyphs;
+	int mGlyphDirect[GLYPH_DIRECT_COUNT];
+	std::vector<GlyphSlot> mGlyphHash;
+	size_t mGlyphHashCount;
+
+	inline Glyph* findGlyph(unsigned int id);
+	Glyph& insertGlyph(unsigned int id);
+	void growGlyphHash();
+
+	// The returned pointer is only valid until the next glyph is loaded.
+	// Unless async is false a missing glyph comes back pending, with only its metrics, and is rasterized on the worker thread.
+	Glyph* getGlyph(unsigned int id, bool async = true);
+	void finishGlyph(Glyph& glyph, const Vector2i& size, const std::vector<unsigned char>& bitmap);
+	unsigned int mGlyphArrivals; // bumped whenever a pending glyph is finished
+	bool placeGlyph(Glyph& glyph); // (re)places the glyph bitmap in the GlyphAtlas
+	Glyph* addGlyph(unsigned int id, const Vector2i& size, const unsigned char* bitmap, int pitch, const Vector2f& advance, const Vector2f& bearing);
+
+	// a CPU copy of every glyph bitmap, glyphs are placed in the atlas again from it after being evicted (or after a reload)
+	// and it's what gets persisted to the on-disk glyph cache, so neither has to go through FreeType again
+	std::vector<unsigned char> mGlyphBitmaps;
+	unsigned long long mGlyphCacheHash; // of the font file (and fallback fonts) the glyphs were rasterized from
+	bool mGlyphCacheDirty;
+
+	static unsigned long long hashFontFiles(FontFile& file);
+	std::string getGlyphCachePath() const;
+	bool loadGlyphCache();
+	void saveGlyphCache();
 
 	int mMaxGlyphHeight;
 
 	const int mSize;
 	const std::string mPath;
 
-	float getNewlineStartOffset(const std::string& text, const unsigned int& charStart, const float& xLen, const Alignment& alignment);
+	float getLineStartOffset(const float& lineWidth, const float& xLen, const Alignment& alignment);
 
 	friend TextCache;
+	friend GlyphRasterizer;
+};
+
+// The result of breaking a string into lines (Font::layoutText()).
+// Lines are stored as byte ranges into the original string instead of a rewritten copy, so the same layout can be used
+// for sizing, building a TextCache and positioning a cursor without wrapping the text again.
+struct TextLayout
+{
+	struct Line
+	{
+		size_t start; // byte offset of the first character of the line
+		size_t end;   // byte offset one past the last character of the line (never includes the newline)
+		float width;
+	};
+
+	std::vector<Line> lines;
+	float width; // width of the widest line
+
+	TextLayout() : width(0.0f) { }
 };
 
 // Used to store a sort of "pre-rendered" string.
 // When a TextCache is constructed (Font::buildTextCache()), the vertices and texture coordinates of the string are calculated and stored in the TextCache object.
 // Rendering a previously constructed TextCache (Font::renderTextCache) every frame is MUCH faster than rebuilding one every frame.
-// Keep in mind you still need the Font object to render a TextCache (as the Font holds the OpenGL texture), and if a Font changes your TextCache may become invalid.
+// Keep in mind you still need the Font object to render a TextCache (it rebuilds the cache if its glyphs were evicted from the atlas), and if a Font changes your TextCache may become invalid.
 class TextCache
 {
 protected:
@@ -145,18 +265,32 @@ protected:
 	struct VertexList
 	{
 		std::vector<Renderer::Vertex> verts;
-		unsigned int* textureIdPtr; // this is a pointer because the texture ID can change during deinit/reinit (when launching a game)
+		GlyphAtlas::Page* page;
+		unsigned int generation; // if the page has moved on since, the glyphs are gone and the cache gets rebuilt
 	};
 
 	std::vector<VertexList> vertexLists;
 
+	// what the cache was built from, so it can be rebuilt when its glyphs get evicted from the atlas
+	std::string text;
+	TextLayout layout;
+	Vector2f offset;
+	unsigned int color;
+	float xLen;
+	Alignment alignment;
+	float lineSpacing;
+
+	bool incomplete; // some glyphs were still pending, rebuilt once the font has received more of them
+	unsigned int glyphArrivals;
+
 public:
 	struct CacheMetrics
 	{
 		Vector2f size;
 	} metrics;
 
-	void setColor(unsigned int color);
+	void setColor(unsigned int color); // don't use this on caches shared through Font::getTextCache(), render them with a color instead
+	size_t getMemUsage() const;
 
 	friend Font;
 };
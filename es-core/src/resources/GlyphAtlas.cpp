@@ -0,0 +1,208 @@
+#include "resources/GlyphAtlas.h"
+
+#include "math/Misc.h"
+#include "renderers/Renderer.h"
+#include "Log.h"
+#include <string.h>
+
+std::shared_ptr<GlyphAtlas> GlyphAtlas::sInstance = nullptr;
+
+GlyphAtlas::Page::Page() : textureId(0), generation(0), lastUsedFrame(0), shelvesBottom(0), dirtyTop(PAGE_SIZE), dirtyBottom(0)
+{
+}
+
+GlyphAtlas::Page::~Page()
+{
+	if(textureId != 0)
+		Renderer::destroyTexture(textureId);
+}
+
+bool GlyphAtlas::Page::findEmpty(const Vector2i& size, Vector2i& cursor_out)
+{
+	// use the shelf that wastes the least height, leaving 1px of space between glyphs
+	Shelf* best = NULL;
+	for(auto it = shelves.begin(); it != shelves.end(); it++)
+	{
+		if(it->height < size.y() || it->x + size.x() >= PAGE_SIZE)
+			continue;
+
+		if(best == NULL || it->height < best->height)
+			best = &(*it);
+	}
+
+	// a shelf much taller than the glyph would waste too much, open a new one if there's still room
+	if((best == NULL || best->height > size.y() + size.y() / 2 + 2) && shelvesBottom + size.y() < PAGE_SIZE && size.x() < PAGE_SIZE)
+	{
+		shelves.push_back({ shelvesBottom, size.y(), 0 });
+		shelvesBottom += size.y() + 1;
+		best = &shelves.back();
+	}
+
+	if(best == NULL)
+		return false;
+
+	cursor_out = Vector2i(best->x, best->y);
+	best->x += size.x() + 1;
+	return true;
+}
+
+void GlyphAtlas::Page::clear()
+{
+	shelves.clear();
+	shelvesBottom = 0;
+	dirtyTop = PAGE_SIZE;
+	dirtyBottom = 0;
+	generation++;
+}
+
+std::shared_ptr<GlyphAtlas>& GlyphAtlas::getInstance()
+{
+	if(!sInstance)
+	{
+		sInstance = std::shared_ptr<GlyphAtlas>(new GlyphAtlas());
+		ResourceManager::getInstance()->addReloadable(sInstance);
+	}
+
+	return sInstance;
+}
+
+GlyphAtlas::GlyphAtlas() : mFrame(1), mDirty(false)
+{
+}
+
+GlyphAtlas::~GlyphAtlas()
+{
+}
+
+GlyphAtlas::Page* GlyphAtlas::add(const Vector2i& size, const unsigned char* bitmap, Vector2i& cursor_out)
+{
+	if(size.x() >= PAGE_SIZE || size.y() >= PAGE_SIZE)
+	{
+		LOG(LogError) << "Glyph too big to fit on a glyph atlas page (glyph size > " << PAGE_SIZE << ", " << PAGE_SIZE << ")!";
+		return NULL;
+	}
+
+	// most recent pages are the most likely to have space
+	Page* page = NULL;
+	for(auto it = mPages.rbegin(); it != mPages.rend(); it++)
+	{
+		if((*it)->findEmpty(size, cursor_out))
+		{
+			page = it->get();
+			break;
+		}
+	}
+
+	if(page == NULL)
+	{
+		page = evictPage();
+		if(page == NULL)
+		{
+			mPages.push_back(std::unique_ptr<Page>(new Page()));
+			page = mPages.back().get();
+		}
+
+		page->findEmpty(size, cursor_out);
+	}
+
+	if(size.x() > 0 && size.y() > 0)
+	{
+		if(page->pixels.empty())
+			page->pixels.resize(PAGE_SIZE * PAGE_SIZE);
+
+		for(int y = 0; y < size.y(); y++)
+			memcpy(&page->pixels[(cursor_out.y() + y) * PAGE_SIZE + cursor_out.x()], bitmap + y * size.x(), size.x());
+
+		page->dirtyTop = Math::min(page->dirtyTop, cursor_out.y());
+		page->dirtyBottom = Math::max(page->dirtyBottom, cursor_out.y() + size.y());
+		mDirty = true;
+	}
+
+	touch(page);
+	return page;
+}
+
+GlyphAtlas::Page* GlyphAtlas::evictPage()
+{
+	if(mPages.size() < MAX_PAGES)
+		return NULL;
+
+	// never take away a page the current frame has already drawn from
+	Page* oldest = NULL;
+	for(auto it = mPages.begin(); it != mPages.end(); it++)
+	{
+		if((*it)->lastUsedFrame != mFrame && (oldest == NULL || (*it)->lastUsedFrame < oldest->lastUsedFrame))
+			oldest = it->get();
+	}
+
+	if(oldest != NULL)
+		oldest->clear();
+
+	return oldest;
+}
+
+void GlyphAtlas::flush()
+{
+	if(!mDirty)
+		return;
+
+	for(auto it = mPages.begin(); it != mPages.end(); it++)
+	{
+		Page* page = it->get();
+		if(page->dirtyTop >= page->dirtyBottom)
+			continue;
+
+		if(page->textureId == 0)
+		{
+			// a new texture gets everything, including rows that were flushed to a previous one
+			page->textureId = Renderer::createTexture(Renderer::Texture::ALPHA, false, false, PAGE_SIZE, PAGE_SIZE, nullptr);
+			page->dirtyTop = 0;
+		}
+
+		// whole rows, so the staging copy can be uploaded as is
+		Renderer::updateTexture(page->textureId, Renderer::Texture::ALPHA, 0, page->dirtyTop, PAGE_SIZE, page->dirtyBottom - page->dirtyTop, &page->pixels[page->dirtyTop * PAGE_SIZE]);
+
+		page->dirtyTop = PAGE_SIZE;
+		page->dirtyBottom = 0;
+	}
+
+	mDirty = false;
+}
+
+size_t GlyphAtlas::getMemUsage() const
+{
+	size_t memUsage = 0;
+	for(auto it = mPages.cbegin(); it != mPages.cend(); it++)
+	{
+		if((*it)->textureId != 0)
+			memUsage += PAGE_SIZE * PAGE_SIZE;
+
+		memUsage += (*it)->pixels.capacity();
+	}
+
+	return memUsage;
+}
+
+void GlyphAtlas::unload(std::shared_ptr<ResourceManager>& /*rm*/)
+{
+	for(auto it = mPages.begin(); it != mPages.end(); it++)
+	{
+		if((*it)->textureId != 0)
+		{
+			Renderer::destroyTexture((*it)->textureId);
+			(*it)->textureId = 0;
+		}
+
+		(*it)->clear();
+
+		// the staging copies are only needed while there's a renderer to upload to
+		std::vector<unsigned char>().swap((*it)->pixels);
+	}
+
+	mDirty = false;
+}
+
+void GlyphAtlas::reload(std::shared_ptr<ResourceManager>& /*rm*/)
+{
+	// textures are recreated as glyphs get placed again
+}
@@ -0,0 +1,79 @@
+#pragma once
+#ifndef ES_CORE_RESOURCES_GLYPH_ATLAS_H
+#define ES_CORE_RESOURCES_GLYPH_ATLAS_H
+
+#include "math/Vector2i.h"
+#include "resources/ResourceManager.h"
+#include <memory>
+#include <vector>
+
+// Alpha texture pages shared by the glyphs of every Font and size.
+// Glyphs are packed onto shelves, when the atlas is full the least recently rendered page is cleared and reused.
+// A cleared page gets a new generation, anything that still refers to an older generation of it
+// (glyphs, TextCaches) has to be placed again, Font takes care of that from its own copy of the glyph bitmaps.
+// The pages are also simply cleared on renderer deinit, so nothing needs to be re-uploaded on reinit.
+// Glyph bitmaps are staged in a CPU copy of each page and uploaded in one go per page by flush(), before text gets drawn.
+class GlyphAtlas : public IReloadable
+{
+public:
+	static const int    PAGE_SIZE = 1024;
+	static const size_t MAX_PAGES = 4; // pages are only added past this if every page was used by the current frame
+
+	struct Page
+	{
+		struct Shelf
+		{
+			int y;
+			int height;
+			int x; // where the next glyph on this shelf goes
+		};
+
+		unsigned int textureId;
+		unsigned int generation;
+		unsigned int lastUsedFrame;
+
+		std::vector<Shelf> shelves;
+		int shelvesBottom; // first row below the last shelf
+
+		std::vector<unsigned char> pixels; // staging copy of the texture
+		int dirtyTop;
+		int dirtyBottom; // rows [dirtyTop, dirtyBottom) still have to be uploaded
+
+		Page();
+		~Page();
+
+		bool findEmpty(const Vector2i& size, Vector2i& cursor_out);
+		void clear();
+	};
+
+	static std::shared_ptr<GlyphAtlas>& getInstance();
+
+	virtual ~GlyphAtlas();
+
+	// Copies a tightly packed alpha bitmap into the atlas, returns the page it went to (NULL if it's too big for a page).
+	// The bitmap only reaches the texture on the next flush().
+	Page* add(const Vector2i& size, const unsigned char* bitmap, Vector2i& cursor_out);
+
+	inline bool isValid(const Page* page, unsigned int generation) const { return page != NULL && page->generation == generation; }
+	inline void touch(Page* page) { page->lastUsedFrame = mFrame; }
+	inline void nextFrame() { mFrame++; }
+	void flush(); // uploads everything added since the last flush
+
+	size_t getMemUsage() const; // returns an approximation of memory used by the atlas pages and their staging copies (in bytes)
+
+	void unload(std::shared_ptr<ResourceManager>& rm) override;
+	void reload(std::shared_ptr<ResourceManager>& rm) override;
+
+private:
+	GlyphAtlas();
+
+	Page* evictPage();
+
+	static std::shared_ptr<GlyphAtlas> sInstance;
+
+	std::vector< std::unique_ptr<Page> > mPages; // glyphs and TextCaches point into these, so they must not move
+	unsigned int mFrame;
+	bool mDirty;
+};
+
+#endif // ES_CORE_RESOURCES_GLYPH_ATLAS_H
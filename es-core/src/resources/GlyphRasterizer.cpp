@@ -0,0 +1,93 @@
+#include "resources/GlyphRasterizer.h"
+
+#include "resources/Font.h"
+#include "Window.h"
+
+GlyphRasterizer::GlyphRasterizer() : mBusyFont(NULL), mExit(false)
+{
+	mThread = new std::thread(&GlyphRasterizer::threadProc, this);
+}
+
+GlyphRasterizer::~GlyphRasterizer()
+{
+	{
+		std::unique_lock<std::mutex> lock(mMutex);
+		mRequests.clear();
+		mExit = true;
+	}
+
+	mEvent.notify_one();
+	mThread->join();
+	delete mThread;
+}
+
+void GlyphRasterizer::threadProc()
+{
+	std::unique_lock<std::mutex> lock(mMutex);
+
+	while(!mExit)
+	{
+		if(mRequests.empty())
+		{
+			mEvent.wait(lock);
+			continue;
+		}
+
+		Result result;
+		result.font = mRequests.front().first;
+		result.id = mRequests.front().second;
+		mRequests.pop_front();
+
+		// the font can't go away while it's busy here, see cancel()
+		mBusyFont = result.font;
+		lock.unlock();
+
+		result.ok = result.font->rasterizeGlyph(result.id, result.size, result.bitmap);
+
+		lock.lock();
+		mResults.push_back(std::move(result));
+		mBusyFont = NULL;
+		mIdle.notify_all();
+
+		// the glyph gets placed by the next render
+		Window::wake();
+	}
+}
+
+void GlyphRasterizer::request(Font* font, unsigned int id)
+{
+	std::unique_lock<std::mutex> lock(mMutex);
+	mRequests.push_back(std::make_pair(font, id));
+	mEvent.notify_one();
+}
+
+void GlyphRasterizer::cancel(Font* font)
+{
+	std::unique_lock<std::mutex> lock(mMutex);
+
+	while(mBusyFont == font)
+		mIdle.wait(lock);
+
+	for(auto it = mRequests.begin(); it != mRequests.end(); )
+	{
+		if(it->first == font)
+			it = mRequests.erase(it);
+		else
+			it++;
+	}
+
+	for(auto it = mResults.begin(); it != mResults.end(); )
+	{
+		if(it->font == font)
+			it = mResults.erase(it);
+		else
+			it++;
+	}
+}
+
+void GlyphRasterizer::collect(std::vector<Result>& results_out)
+{
+	std::unique_lock<std::mutex> lock(mMutex);
+	results_out.swap(mResults);
+	mResults.clear();
+}
@@ -0,0 +1,49 @@
+#pragma once
+#ifndef ES_CORE_RESOURCES_GLYPH_RASTERIZER_H
+#define ES_CORE_RESOURCES_GLYPH_RASTERIZER_H
+
+#include "math/Vector2i.h"
+#include <condition_variable>
+#include <list>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class Font;
+
+// Rasterizes the glyphs Font::getGlyph() couldn't find on a worker thread.
+// Finished bitmaps wait here until the main thread collects them (Font::processRasterizedGlyphs(), once per frame).
+class GlyphRasterizer
+{
+public:
+	struct Result
+	{
+		Font* font;
+		unsigned int id;
+		Vector2i size;
+		std::vector<unsigned char> bitmap; // tightly packed
+		bool ok;
+	};
+
+	GlyphRasterizer();
+	~GlyphRasterizer();
+
+	void request(Font* font, unsigned int id);
+	void cancel(Font* font); // forgets everything queued or finished for font, waits for the worker if it's busy with it
+	void collect(std::vector<Result>& results_out);
+
+private:
+	void threadProc();
+
+	std::list< std::pair<Font*, unsigned int> > mRequests;
+	std::vector<Result>                         mResults;
+	Font*                                       mBusyFont;
+
+	std::thread*            mThread;
+	std::mutex              mMutex;
+	std::condition_variable mEvent;
+	std::condition_variable mIdle;
+	bool                    mExit;
+};
+
+#endif // ES_CORE_RESOURCES_GLYPH_RASTERIZER_H
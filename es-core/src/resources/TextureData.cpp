@@ -143,6 +143,9 @@ bool TextureData::load()
 		}
 		else
 			retval = initImageFromMemory((const unsigned char*)data.ptr.get(), data.length);
+
+		if(retval)
+			Renderer::countTextureDecoded();
 	}
 	return retval;
 }
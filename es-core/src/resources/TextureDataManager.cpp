@@ -3,6 +3,7 @@
 #include "resources/TextureData.h"
 #include "resources/TextureResource.h"
 #include "Settings.h"
+#include "Window.h"
 
 TextureDataManager::TextureDataManager()
 {
@@ -39,6 +40,8 @@ void TextureDataManager::remove(const TextureResource* key)
 	auto it = mTextureLookup.find(key);
 	if (it != mTextureLookup.cend())
 	{
+		// Nobody wants it anymore, so don't bother loading it if it's still queued
+		mLoader->remove(*(*it).second);
 		// Remove the list entry
 		mTextures.erase((*it).second);
 		// And the lookup
@@ -166,6 +169,9 @@ void TextureLoader::threadProc()
 		{
 			textureData->load();
 
+			// whatever is waiting for this texture can be drawn now
+			Window::wake();
+
 			// See if there is another item in the queue
 			textureData = nullptr;
 			std::unique_lock<std::mutex> lock(mMutex);
@@ -235,24 +235,29 @@ namespace Utils
 
 		std::string getGenericPath(const std::string& _path)
 		{
-			std::string path   = _path;
-			size_t      offset = std::string::npos;
+			std::string path;
+			size_t      offset = 0;
+
+			path.reserve(_path.length());
 
 			// remove "\\\\?\\"
-			if((path.find("\\\\?\\")) == 0)
-				path.erase(0, 4);
+			if(_path.compare(0, 4, "\\\\?\\") == 0)
+				offset = 4;
 
-			// convert '\\' to '/'
-			while((offset = path.find('\\')) != std::string::npos)
-				path.replace(offset, 1 ,"/");
+			// convert '\\' to '/' and remove double '/' in a single pass
+			for(; offset < _path.length(); ++offset)
+			{
+				const char c = (_path[offset] == '\\') ? '/' : _path[offset];
+
+				if((c == '/') && path.length() && (path.back() == '/'))
+					continue;
 
-			// remove double '/'
-			while((offset = path.find("//")) != std::string::npos)
-				path.erase(offset, 1);
+				path += c;
+			}
 
 			// remove trailing '/' when the path is more than a simple '/'
-			while(path.length() > 1 && ((offset = path.find_last_of('/')) == (path.length() - 1)))
-				path.erase(offset, 1);
+			if((path.length() > 1) && (path.back() == '/'))
+				path.pop_back();
 
 			// return generic path
 			return path;
@@ -490,7 +495,7 @@ namespace Utils
 			std::string common = isDirectory(_common) ? getGenericPath(_common) : getParent(_common);
 
 			// check if path contains common
-			if(path.find(common) == 0)
+			if(path.compare(0, common.length(), common) == 0)
 			{
 				_contains = true;
 				return path.substr(common.length() + 1);
@@ -584,6 +589,32 @@ namespace Utils
 
 		} // exists
 
+		long long getFileSize(const std::string& _path)
+		{
+			std::string path = getGenericPath(_path);
+			struct stat64 info;
+
+			// check if stat64 succeeded
+			if(stat64(path.c_str(), &info) != 0)
+				return -1;
+
+			return (long long)info.st_size;
+
+		} // getFileSize
+
+		long long getModifiedTime(const std::string& _path)
+		{
+			std::string path = getGenericPath(_path);
+			struct stat64 info;
+
+			// check if stat64 succeeded
+			if(stat64(path.c_str(), &info) != 0)
+				return -1;
+
+			return (long long)info.st_mtime;
+
+		} // getModifiedTime
+
 		bool isAbsolute(const std::string& _path)
 		{
 			std::string path = getGenericPath(_path);
@@ -34,6 +34,8 @@ namespace Utils
 		bool        removeFile         (const std::string& _path);
 		bool        createDirectory    (const std::string& _path);
 		bool        exists             (const std::string& _path);
+		long long   getFileSize        (const std::string& _path); // -1 if it doesn't exist
+		long long   getModifiedTime    (const std::string& _path); // seconds since the epoch, -1 if it doesn't exist
 		bool        isAbsolute         (const std::string& _path);
 		bool        isRegularFile      (const std::string& _path);
 		bool        isDirectory        (const std::string& _path);
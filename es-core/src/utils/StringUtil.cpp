@@ -2,6 +2,11 @@
 
 #include <algorithm>
 #include <stdarg.h>
+#include <string.h>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
 
 namespace Utils
 {
@@ -135,28 +140,116 @@ namespace Utils
 
 		} // moveCursor
 
-		std::string toLower(const std::string& _string)
+		// case conversion only ever touches ASCII (like toupper()/tolower() in the "C" locale we run in),
+		// so it can be done 16 bytes at a time and UTF-8 sequences pass through untouched
+		static inline char asciiToUpper(const char _c) { return ((_c >= 'a') && (_c <= 'z')) ? (char)(_c - 0x20) : _c; }
+		static inline char asciiToLower(const char _c) { return ((_c >= 'A') && (_c <= 'Z')) ? (char)(_c + 0x20) : _c; }
+
+#if defined(__SSE2__)
+		static inline __m128i asciiToUpper16(const __m128i _chars)
 		{
-			std::string string;
+			// signed compares are fine, everything outside of ASCII is negative
+			const __m128i lower = _mm_and_si128(_mm_cmpgt_epi8(_chars, _mm_set1_epi8('a' - 1)), _mm_cmplt_epi8(_chars, _mm_set1_epi8('z' + 1)));
+			return _mm_sub_epi8(_chars, _mm_and_si128(lower, _mm_set1_epi8(0x20)));
+		}
+
+		static inline __m128i asciiToLower16(const __m128i _chars)
+		{
+			const __m128i upper = _mm_and_si128(_mm_cmpgt_epi8(_chars, _mm_set1_epi8('A' - 1)), _mm_cmplt_epi8(_chars, _mm_set1_epi8('Z' + 1)));
+			return _mm_add_epi8(_chars, _mm_and_si128(upper, _mm_set1_epi8(0x20)));
+		}
+#endif // __SSE2__
 
-			for(size_t i = 0; i < _string.length(); ++i)
-				string += (char)tolower(_string[i]);
+		void toLowerInPlace(std::string& _string)
+		{
+			char*        chars  = &_string[0];
+			const size_t length = _string.length();
+			size_t       i      = 0;
+
+#if defined(__SSE2__)
+			for(; i + 16 <= length; i += 16)
+				_mm_storeu_si128((__m128i*)(chars + i), asciiToLower16(_mm_loadu_si128((const __m128i*)(chars + i))));
+#endif // __SSE2__
+
+			for(; i < length; ++i)
+				chars[i] = asciiToLower(chars[i]);
+
+		} // toLowerInPlace
+
+		void toUpperInPlace(std::string& _string)
+		{
+			char*        chars  = &_string[0];
+			const size_t length = _string.length();
+			size_t       i      = 0;
 
+#if defined(__SSE2__)
+			for(; i + 16 <= length; i += 16)
+				_mm_storeu_si128((__m128i*)(chars + i), asciiToUpper16(_mm_loadu_si128((const __m128i*)(chars + i))));
+#endif // __SSE2__
+
+			for(; i < length; ++i)
+				chars[i] = asciiToUpper(chars[i]);
+
+		} // toUpperInPlace
+
+		std::string toLower(const std::string& _string)
+		{
+			std::string string = _string;
+			toLowerInPlace(string);
 			return string;
 
 		} // toLower
 
 		std::string toUpper(const std::string& _string)
 		{
-			std::string string;
-
-			for(size_t i = 0; i < _string.length(); ++i)
-				string += (char)toupper(_string[i]);
-
+			std::string string = _string;
+			toUpperInPlace(string);
 			return string;
 
 		} // toUpper
 
+		int compareIgnoreCase(const std::string& _string1, const std::string& _string2)
+		{
+			const char*  chars1 = _string1.c_str();
+			const char*  chars2 = _string2.c_str();
+			const size_t length = std::min(_string1.length(), _string2.length());
+			size_t       i      = 0;
+
+#if defined(__SSE2__)
+			// skip over the part that's equal once folded, 16 bytes at a time
+			for(; i + 16 <= length; i += 16)
+			{
+				const __m128i upper1 = asciiToUpper16(_mm_loadu_si128((const __m128i*)(chars1 + i)));
+				const __m128i upper2 = asciiToUpper16(_mm_loadu_si128((const __m128i*)(chars2 + i)));
+
+				if(_mm_movemask_epi8(_mm_cmpeq_epi8(upper1, upper2)) != 0xFFFF)
+					break;
+			}
+#endif // __SSE2__
+
+			for(; i < length; ++i)
+			{
+				// bytes compare unsigned, like std::string::compare()
+				const unsigned char c1 = (unsigned char)asciiToUpper(chars1[i]);
+				const unsigned char c2 = (unsigned char)asciiToUpper(chars2[i]);
+
+				if(c1 != c2)
+					return (c1 < c2) ? -1 : 1;
+			}
+
+			if(_string1.length() == _string2.length())
+				return 0;
+
+			return (_string1.length() < _string2.length()) ? -1 : 1;
+
+		} // compareIgnoreCase
+
+		bool equalsIgnoreCase(const std::string& _string1, const std::string& _string2)
+		{
+			return (_string1.length() == _string2.length()) && (compareIgnoreCase(_string1, _string2) == 0);
+
+		} // equalsIgnoreCase
+
 		std::string trim(const std::string& _string)
 		{
 			const size_t strBegin = _string.find_first_not_of(" \t");
@@ -169,13 +262,28 @@ namespace Utils
 
 		} // trim
 
+		void trimInPlace(std::string& _string)
+		{
+			const size_t strEnd = _string.find_last_not_of(" \t");
+
+			if(strEnd == std::string::npos)
+			{
+				_string.clear();
+				return;
+			}
+
+			_string.erase(strEnd + 1);
+			_string.erase(0, _string.find_first_not_of(" \t"));
+
+		} // trimInPlace
+
 		std::string replace(const std::string& _string, const std::string& _replace, const std::string& _with)
 		{
 			std::string string = _string;
 			size_t      pos;
 
 			while((pos = string.find(_replace)) != std::string::npos)
-				string = string.replace(pos, _replace.length(), _with.c_str(), _with.length());
+				string.replace(pos, _replace.length(), _with.c_str(), _with.length());
 
 			return string;
 
@@ -183,13 +291,13 @@ namespace Utils
 
 		bool startsWith(const std::string& _string, const std::string& _start)
 		{
-			return (_string.find(_start) == 0);
+			return (_string.size() >= _start.size()) && (_string.compare(0, _start.size(), _start) == 0);
 
 		} // startsWith
 
 		bool endsWith(const std::string& _string, const std::string& _end)
 		{
-			return (_string.find(_end) == (_string.size() - _end.size()));
+			return (_string.size() >= _end.size()) && (_string.compare(_string.size() - _end.size(), _end.size(), _end) == 0);
 
 		} // endsWith
 
@@ -218,7 +326,8 @@ namespace Utils
 				}
 			}
 
-			return trim(string);
+			trimInPlace(string);
+			return string;
 
 		} // removeParenthesis
 
@@ -18,7 +18,12 @@ namespace Utils
 		size_t       moveCursor             (const std::string& _string, const size_t _cursor, const int _amount);
 		std::string  toLower                (const std::string& _string);
 		std::string  toUpper                (const std::string& _string);
+		void         toLowerInPlace         (std::string& _string);
+		void         toUpperInPlace         (std::string& _string);
+		int          compareIgnoreCase      (const std::string& _string1, const std::string& _string2); // same order as comparing toUpper() of both, without the copies
+		bool         equalsIgnoreCase       (const std::string& _string1, const std::string& _string2);
 		std::string  trim                   (const std::string& _string);
+		void         trimInPlace            (std::string& _string);
 		std::string  replace                (const std::string& _string, const std::string& _replace, const std::string& _with);
 		bool         startsWith             (const std::string& _string, const std::string& _start);
 		bool         endsWith               (const std::string& _string, const std::string& _end);
@@ -0,0 +1,138 @@
+#include "resources/Font.h"
+#include "Tests.h"
+#include <string.h>
+
+// a gamelist's worth of names (with the accents and punctuation scrapers bring in) and a few descriptions of typical length
+static const char* const gameNames[] = {
+	"Super Mario Bros. 3",
+	"The Legend of Zelda: A Link to the Past",
+	"Castlevania: Symphony of the Night",
+	"Pokémon Yellow Version: Special Pikachu Edition",
+	"Street Fighter II' Turbo: Hyper Fighting",
+	"Final Fantasy VI",
+	"Chrono Trigger",
+	"Metroid Fusion",
+	"Sonic the Hedgehog 2",
+	"Teenage Mutant Ninja Turtles IV: Turtles in Time",
+	"Mega Man X",
+	"Donkey Kong Country 2: Diddy’s Kong Quest",
+	"Contra III: The Alien Wars",
+	"Kirby’s Dream Land",
+	"Tetris",
+	"Star Fox",
+	"EarthBound",
+	"Secret of Mana",
+	"Super Castlevania IV",
+	"F-Zero",
+	"ActRaiser",
+	"Gradius III",
+	"Ninja Gaiden II: The Dark Sword of Chaos",
+	"Mike Tyson’s Punch-Out!!",
+	"Adventure Island",
+	"Bomberman ’93",
+	"Dr. Mario",
+	"Lufia II: Rise of the Sinistrals",
+	"Tōkidenshō Angel Eyes",
+	"Astérix & Obélix",
+	"Die Schlümpfe",
+	"Mystic Quest Legend",
+	"Shin Megami Tensei™ — Devil Summoner",
+	"R-Type Δ",
+	"Gunstar Heroes",
+	"Streets of Rage 2",
+	"Phantasy Star IV: The End of the Millennium",
+	"Shinobi III: Return of the Ninja Master",
+	"Ecco the Dolphin",
+	"Comix Zone"
+};
+
+static const char* const gameDescriptions[] = {
+	"A side-scrolling platformer in which the player guides two brothers through eight themed worlds, each ending in a fortress guarded by "
+	"one of the villain’s children. New suits grant abilities such as flight, swimming and throwing hammers, and a world map lets players "
+	"choose their path, find hidden whistles and collect items to use before a level starts.",
+
+	"An action role-playing game set in a kingdom split between a Light World and a Dark World. The hero explores dungeons filled with "
+	"puzzles and monsters, gathering the items needed to reach each dungeon’s boss — a hookshot, a magic mirror, the Pegasus Boots — and "
+	"recovering the pendants and crystals that lead to the final confrontation.\n\nSave slots let three players keep separate progress.",
+
+	"Conquer the night in this gothic adventure: explore a vast castle that keeps opening up as new abilities are found, level up, equip "
+	"weapons, armour and relics, and uncover the “inverted” castle hidden behind the ending most players reach first. Over a hundred "
+	"enemies, dozens of spells and a soundtrack that moves from baroque organ to rock keep the journey fresh.",
+
+	"Seven years after the last war, a band of rebels fights an empire that has rediscovered magic by draining it from mythical creatures. "
+	"A cast of fourteen playable characters — a thief, a gambler, a knight, a wild child raised on the Veldt — each brings a unique "
+	"ability to turn-based battles.\n\nThe story splits halfway through, and the world map changes for good.",
+
+	"Pilot a prototype fighter through six stages of horizontally scrolling shoot-’em-up action. Capsules left by destroyed enemies "
+	"advance a power-up bar: speed, missiles, double shot, laser, options and a shield can be chosen in any order. Bosses have weak "
+	"points that must be hit through gaps in their armour, and the later loops raise the difficulty considerably.",
+
+	"Les héros gaulois partent à Rome pour sauver leur ami. Le joueur choisit Astérix ou Obélix et traverse les forêts, les camps romains "
+	"et les rues de la capitale, en ramassant des os, des potions et des clés. Chaque niveau cache des salles secrètes et des bonus."
+};
+
+namespace Tests
+{
+	void textLayoutBenchmark()
+	{
+		const unsigned int nameCount        = sizeof(gameNames) / sizeof(gameNames[0]);
+		const unsigned int descriptionCount = sizeof(gameDescriptions) / sizeof(gameDescriptions[0]);
+
+		const std::shared_ptr<Font> listFont        = Font::get(32);
+		const std::shared_ptr<Font> descriptionFont = Font::get(20);
+
+		// load everything up front so the timings are for layout only, not rasterizing
+		Font::prewarmGlyphs();
+		for(unsigned int i = 0; i < nameCount; i++)
+			listFont->sizeText(gameNames[i]);
+		for(unsigned int i = 0; i < descriptionCount; i++)
+			descriptionFont->sizeText(gameDescriptions[i]);
+
+		static volatile float sink = 0.0f;
+		TextLayout            layout;
+
+		benchmark("sizeText, game names", 2000, [&]()
+		{
+			for(unsigned int i = 0; i < nameCount; i++)
+				sink = sink + listFont->sizeText(gameNames[i]).x();
+		});
+
+		benchmark("layoutText + sizeLayout, game names", 2000, [&]()
+		{
+			for(unsigned int i = 0; i < nameCount; i++)
+			{
+				listFont->layoutText(gameNames[i], 0.0f, layout);
+				sink = sink + listFont->sizeLayout(layout).x();
+			}
+		});
+
+		benchmark("wrapText, descriptions at 640px", 500, [&]()
+		{
+			for(unsigned int i = 0; i < descriptionCount; i++)
+				sink = sink + (float)descriptionFont->wrapText(gameDescriptions[i], 640.0f).size();
+		});
+
+		benchmark("sizeWrappedText, descriptions at 640px", 500, [&]()
+		{
+			for(unsigned int i = 0; i < descriptionCount; i++)
+				sink = sink + descriptionFont->sizeWrappedText(gameDescriptions[i], 640.0f).y();
+		});
+
+		benchmark("layoutText + sizeLayout, descriptions at 640px", 500, [&]()
+		{
+			for(unsigned int i = 0; i < descriptionCount; i++)
+			{
+				descriptionFont->layoutText(gameDescriptions[i], 640.0f, layout);
+				sink = sink + descriptionFont->sizeLayout(layout).y();
+			}
+		});
+
+		benchmark("getWrappedTextCursorOffset, descriptions at 640px", 500, [&]()
+		{
+			for(unsigned int i = 0; i < descriptionCount; i++)
+				sink = sink + descriptionFont->getWrappedTextCursorOffset(gameDescriptions[i], 640.0f, strlen(gameDescriptions[i])).y();
+		});
+
+	} // textLayoutBenchmark
+
+} // Tests::
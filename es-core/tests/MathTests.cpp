@@ -0,0 +1,273 @@
+#include "math/Transform4x4f.h"
+#include "Tests.h"
+#include <iostream>
+#include <math.h>
+#include <random>
+#include <string.h>
+#include <vector>
+
+// the SIMD paths in Transform4x4f promise the exact same floats as the scalar code, the reference below redoes the
+// scalar math with every step rounded to float so the compiler can't turn it into fused multiply-adds either
+static float mul(const float _a, const float _b) { volatile float r = _a * _b; return r; }
+static float add(const float _a, const float _b) { volatile float r = _a + _b; return r; }
+
+static float dot3(const float* _tm, const int _row, const float* _v)
+{
+	return add(add(mul(_tm[_row], _v[0]), mul(_tm[_row + 4], _v[1])), mul(_tm[_row + 8], _v[2]));
+
+} // dot3
+
+static Transform4x4f referenceMultiply(const Transform4x4f& _a, const Transform4x4f& _b)
+{
+	const float*  tm = (const float*)&_a;
+	const float*  om = (const float*)&_b;
+	Transform4x4f result;
+	float*        rm = (float*)&result;
+
+	for(int i = 0; i < 4; ++i)
+	{
+		for(int row = 0; row < 3; ++row)
+			rm[i * 4 + row] = (i == 3) ? add(dot3(tm, row, &om[i * 4]), tm[12 + row]) : dot3(tm, row, &om[i * 4]);
+
+		rm[i * 4 + 3] = (i == 3) ? 1.0f : 0.0f;
+	}
+
+	return result;
+
+} // referenceMultiply
+
+static Vector3f referenceTransform(const Transform4x4f& _a, const Vector3f& _v)
+{
+	const float* tm = (const float*)&_a;
+	const float* ov = (const float*)&_v;
+
+	return { add(dot3(tm, 0, ov), tm[12]), add(dot3(tm, 1, ov), tm[13]), add(dot3(tm, 2, ov), tm[14]) };
+
+} // referenceTransform
+
+static Transform4x4f referenceTranslate(const Transform4x4f& _a, const Vector3f& _v)
+{
+	Transform4x4f result = _a;
+	float*        tm     = (float*)&result;
+	const float*  tv     = (const float*)&_v;
+
+	for(int row = 0; row < 3; ++row)
+		tm[12 + row] = add(tm[12 + row], dot3(tm, row, tv));
+
+	return result;
+
+} // referenceTranslate
+
+// the scalar code the SIMD paths replaced, for timing against
+// the SIMD versions are out of line in es-core, these are kept out of line too so only the math itself is compared
+#if defined(_MSC_VER)
+#define NOINLINE __declspec(noinline)
+#else
+#define NOINLINE __attribute__((noinline))
+#endif
+
+NOINLINE static Transform4x4f scalarMultiply(const Transform4x4f& _a, const Transform4x4f& _b)
+{
+	const float* tm = (const float*)&_a;
+	const float* om = (const float*)&_b;
+
+	return
+	{
+		{
+			tm[ 0] * om[ 0] + tm[ 4] * om[ 1] + tm[ 8] * om[ 2],
+			tm[ 1] * om[ 0] + tm[ 5] * om[ 1] + tm[ 9] * om[ 2],
+			tm[ 2] * om[ 0] + tm[ 6] * om[ 1] + tm[10] * om[ 2],
+			0
+		},
+		{
+			tm[ 0] * om[ 4] + tm[ 4] * om[ 5] + tm[ 8] * om[ 6],
+			tm[ 1] * om[ 4] + tm[ 5] * om[ 5] + tm[ 9] * om[ 6],
+			tm[ 2] * om[ 4] + tm[ 6] * om[ 5] + tm[10] * om[ 6],
+			0
+		},
+		{
+			tm[ 0] * om[ 8] + tm[ 4] * om[ 9] + tm[ 8] * om[10],
+			tm[ 1] * om[ 8] + tm[ 5] * om[ 9] + tm[ 9] * om[10],
+			tm[ 2] * om[ 8] + tm[ 6] * om[ 9] + tm[10] * om[10],
+			0
+		},
+		{
+			tm[ 0] * om[12] + tm[ 4] * om[13] + tm[ 8] * om[14] + tm[12],
+			tm[ 1] * om[12] + tm[ 5] * om[13] + tm[ 9] * om[14] + tm[13],
+			tm[ 2] * om[12] + tm[ 6] * om[13] + tm[10] * om[14] + tm[14],
+			1
+		}
+	};
+
+} // scalarMultiply
+
+NOINLINE static Vector3f scalarTransform(const Transform4x4f& _a, const Vector3f& _v)
+{
+	const float* tm = (const float*)&_a;
+	const float* ov = (const float*)&_v;
+
+	return
+	{
+		tm[ 0] * ov[0] + tm[ 4] * ov[1] + tm[ 8] * ov[2] + tm[12],
+		tm[ 1] * ov[0] + tm[ 5] * ov[1] + tm[ 9] * ov[2] + tm[13],
+		tm[ 2] * ov[0] + tm[ 6] * ov[1] + tm[10] * ov[2] + tm[14]
+	};
+
+} // scalarTransform
+
+NOINLINE static void scalarTranslate(Transform4x4f& _a, const Vector3f& _v)
+{
+	float*       tm = (float*)&_a;
+	const float* tv = (const float*)&_v;
+
+	tm[12] += tm[ 0] * tv[0] + tm[ 4] * tv[1] + tm[ 8] * tv[2];
+	tm[13] += tm[ 1] * tv[0] + tm[ 5] * tv[1] + tm[ 9] * tv[2];
+	tm[14] += tm[ 2] * tv[0] + tm[ 6] * tv[1] + tm[10] * tv[2];
+
+} // scalarTranslate
+
+// finite values across a wide range of magnitudes, with some exact (negative) zeros thrown in, the sums never overflow
+static float randomFloat(std::mt19937& _rng)
+{
+	const unsigned int bits = _rng();
+
+	if((bits & 15) == 0)
+		return (bits & 16) ? -0.0f : 0.0f;
+
+	const float mantissa = std::uniform_real_distribution<float>(1.0f, 2.0f)(_rng);
+	const int   exponent = (int)(_rng() % 61) - 30;
+
+	return ldexpf((bits & 32) ? -mantissa : mantissa, exponent);
+
+} // randomFloat
+
+static Transform4x4f randomTransform(std::mt19937& _rng)
+{
+	return { { randomFloat(_rng), randomFloat(_rng), randomFloat(_rng), 0 },
+	         { randomFloat(_rng), randomFloat(_rng), randomFloat(_rng), 0 },
+	         { randomFloat(_rng), randomFloat(_rng), randomFloat(_rng), 0 },
+	         { randomFloat(_rng), randomFloat(_rng), randomFloat(_rng), 1 } };
+
+} // randomTransform
+
+static Vector3f randomVector(std::mt19937& _rng)
+{
+	return { randomFloat(_rng), randomFloat(_rng), randomFloat(_rng) };
+
+} // randomVector
+
+static bool sameBits(const char* _what, const float* _expected, const float* _actual, const int _count)
+{
+	if(memcmp(_expected, _actual, _count * sizeof(float)) == 0)
+		return true;
+
+	std::cout << _what << " differs from the scalar reference:\n";
+	for(int i = 0; i < _count; ++i)
+	{
+		if(memcmp(&_expected[i], &_actual[i], sizeof(float)) != 0)
+			std::cout << "  [" << i << "] expected " << std::hexfloat << _expected[i] << ", got " << _actual[i] << std::defaultfloat << "\n";
+	}
+
+	return false;
+
+} // sameBits
+
+namespace Tests
+{
+	bool transform4x4fSimd()
+	{
+		std::mt19937 rng(68);
+
+		for(int i = 0; i < 100000; ++i)
+		{
+			const Transform4x4f a = randomTransform(rng);
+			const Transform4x4f b = randomTransform(rng);
+			const Vector3f      v = randomVector(rng);
+
+			const Transform4x4f expectedProduct   = referenceMultiply(a, b);
+			const Transform4x4f product           = a * b;
+			const Vector3f      expectedPoint     = referenceTransform(a, v);
+			const Vector3f      point             = a * v;
+			const Transform4x4f expectedTranslate = referenceTranslate(a, v);
+			Transform4x4f       translated        = a;
+			translated.translate(v);
+
+			if(!sameBits("operator*(Transform4x4f)", (const float*)&expectedProduct,   (const float*)&product,    16) ||
+			   !sameBits("operator*(Vector3f)",      (const float*)&expectedPoint,     (const float*)&point,       3) ||
+			   !sameBits("translate",                (const float*)&expectedTranslate, (const float*)&translated, 16))
+				return false;
+		}
+
+		return true;
+
+	} // transform4x4fSimd
+
+	void mathBenchmark()
+	{
+		// about what a frame of a busy gamelist goes through, with small values so nothing overflows over the iterations
+		std::mt19937                  rng(68);
+		std::vector<Transform4x4f>    transforms;
+		std::vector<Vector3f>         vectors;
+		std::vector<Transform4x4f>    results(1024);
+		std::vector<Vector3f>         points(1024);
+		static volatile float         sink = 0.0f;
+
+		for(int i = 0; i < 1024; ++i)
+		{
+			Transform4x4f transform = Transform4x4f::Identity();
+			transform.translate(Vector3f((float)(i % 32), (float)(i / 32), 0.0f)).rotateZ(i * 0.01f).scale(Vector3f(1.0f + (rng() % 8) / 8.0f));
+			transforms.push_back(transform);
+			vectors.push_back(Vector3f((float)(rng() % 1920), (float)(rng() % 1080), 0.0f));
+		}
+
+		benchmark("Transform4x4f * Transform4x4f, 1024", 5000, [&]()
+		{
+			for(int i = 0; i < 1024; ++i)
+				results[i] = transforms[i] * transforms[(i + 1) & 1023];
+			sink = sink + results[rng() & 1023].r3().x();
+		});
+
+		benchmark("Transform4x4f * Transform4x4f, 1024 (scalar)", 5000, [&]()
+		{
+			for(int i = 0; i < 1024; ++i)
+				results[i] = scalarMultiply(transforms[i], transforms[(i + 1) & 1023]);
+			sink = sink + results[rng() & 1023].r3().x();
+		});
+
+		benchmark("Transform4x4f * Vector3f, 1024", 5000, [&]()
+		{
+			for(int i = 0; i < 1024; ++i)
+				points[i] = transforms[i] * vectors[i];
+			sink = sink + points[rng() & 1023].x();
+		});
+
+		benchmark("Transform4x4f * Vector3f, 1024 (scalar)", 5000, [&]()
+		{
+			for(int i = 0; i < 1024; ++i)
+				points[i] = scalarTransform(transforms[i], vectors[i]);
+			sink = sink + points[rng() & 1023].x();
+		});
+
+		benchmark("Transform4x4f::translate, 1024", 5000, [&]()
+		{
+			for(int i = 0; i < 1024; ++i)
+			{
+				results[i] = transforms[i];
+				results[i].translate(vectors[i]);
+			}
+			sink = sink + results[rng() & 1023].r3().x();
+		});
+
+		benchmark("Transform4x4f::translate, 1024 (scalar)", 5000, [&]()
+		{
+			for(int i = 0; i < 1024; ++i)
+			{
+				results[i] = transforms[i];
+				scalarTranslate(results[i], vectors[i]);
+			}
+			sink = sink + results[rng() & 1023].r3().x();
+		});
+
+	} // mathBenchmark
+
+} // Tests::
@@ -0,0 +1,238 @@
+#include "utils/FileSystemUtil.h"
+#include "utils/StringUtil.h"
+#include "Tests.h"
+#include <algorithm>
+#include <ctype.h>
+#include <iostream>
+#include <random>
+
+// the implementations the copy-free versions replaced, they're what the new ones have to match
+static std::string referenceToUpper(const std::string& _string)
+{
+	std::string string;
+
+	for(size_t i = 0; i < _string.length(); ++i)
+		string += (char)toupper((unsigned char)_string[i]);
+
+	return string;
+
+} // referenceToUpper
+
+static std::string referenceToLower(const std::string& _string)
+{
+	std::string string;
+
+	for(size_t i = 0; i < _string.length(); ++i)
+		string += (char)tolower((unsigned char)_string[i]);
+
+	return string;
+
+} // referenceToLower
+
+static int referenceCompareIgnoreCase(const std::string& _string1, const std::string& _string2)
+{
+	const int result = referenceToUpper(_string1).compare(referenceToUpper(_string2));
+
+	return (result < 0) ? -1 : ((result > 0) ? 1 : 0);
+
+} // referenceCompareIgnoreCase
+
+static std::string referenceGetGenericPath(const std::string& _path)
+{
+	std::string path   = _path;
+	size_t      offset = std::string::npos;
+
+	// remove "\\\\?\\"
+	if((path.find("\\\\?\\")) == 0)
+		path.erase(0, 4);
+
+	// convert '\\' to '/'
+	while((offset = path.find('\\')) != std::string::npos)
+		path.replace(offset, 1 ,"/");
+
+	// remove double '/'
+	while((offset = path.find("//")) != std::string::npos)
+		path.erase(offset, 1);
+
+	// remove trailing '/' when the path is more than a simple '/'
+	while(path.length() > 1 && ((offset = path.find_last_of('/')) == (path.length() - 1)))
+		path.erase(offset, 1);
+
+	return path;
+
+} // referenceGetGenericPath
+
+// long enough to cross the 16 byte SIMD blocks, drawn mostly from the characters around the case conversion boundaries
+static std::string randomString(std::mt19937& _rng, const char* _alphabet, const size_t _alphabetLength)
+{
+	const size_t length = _rng() % 80;
+	std::string  string;
+
+	for(size_t i = 0; i < length; ++i)
+		string += _alphabet[_rng() % _alphabetLength];
+
+	return string;
+
+} // randomString
+
+// like _string but with its case flipped here and there and the odd byte changed, so comparisons share long prefixes
+static std::string randomVariant(std::mt19937& _rng, const std::string& _string, const char* _alphabet, const size_t _alphabetLength)
+{
+	std::string string = _string;
+
+	for(size_t i = 0; i < string.length(); ++i)
+	{
+		const unsigned int roll = _rng() % 64;
+
+		if(roll < 16)
+			string[i] = (char)(isupper((unsigned char)string[i]) ? tolower((unsigned char)string[i]) : toupper((unsigned char)string[i]));
+		else if(roll == 16)
+			string[i] = _alphabet[_rng() % _alphabetLength];
+	}
+
+	if((_rng() % 8) == 0)
+		string.resize(_rng() % (string.length() + 1));
+	else if((_rng() % 8) == 0)
+		string += _alphabet[_rng() % _alphabetLength];
+
+	return string;
+
+} // randomVariant
+
+static bool mismatch(const char* _what, const std::string& _input, const std::string& _expected, const std::string& _actual)
+{
+	std::cout << _what << " differs from the reference for \"" << _input << "\": expected \"" << _expected << "\", got \"" << _actual << "\"\n";
+	return false;
+
+} // mismatch
+
+// a sorted gamelist's worth of names, the way FileSorts compares them
+static std::vector<std::string> randomNames(std::mt19937& _rng, const unsigned int _count)
+{
+	static const char* const words[] = { "Super", "the", "Legend", "of", "Mario", "World", "Zelda", "Castlevania", "Street", "Fighter",
+	                                     "II", "Turbo", "Final", "Fantasy", "Pokémon", "Sonic", "Hedgehog", "Mega", "Man", "X", "Kong",
+	                                     "Quest", "Dragon", "Warrior", "Ninja", "Gaiden", "Contra", "Star", "Fox", "Astérix", "3", "'93" };
+	std::vector<std::string> names;
+
+	for(unsigned int i = 0; i < _count; ++i)
+	{
+		std::string  name;
+		const size_t wordCount = 1 + _rng() % 6;
+
+		for(size_t w = 0; w < wordCount; ++w)
+			name += (w ? " " : "") + std::string(words[_rng() % (sizeof(words) / sizeof(words[0]))]);
+
+		if(_rng() % 4 == 0)
+			name = referenceToUpper(name);
+
+		names.push_back(name);
+	}
+
+	return names;
+
+} // randomNames
+
+namespace Tests
+{
+	bool stringUtilEquivalence()
+	{
+		static const char textAlphabet[] = "aAbBmMyYzZ@[`{09 \t_\xc3\xa9\xc3\x89\xe2\x80\x99\xff";
+		static const char pathAlphabet[] = "\\\\//?:aB.";
+
+		std::mt19937 rng(59);
+
+		for(int i = 0; i < 100000; ++i)
+		{
+			const std::string text  = randomString(rng, textAlphabet, sizeof(textAlphabet) - 1);
+			const std::string other = randomVariant(rng, text, textAlphabet, sizeof(textAlphabet) - 1);
+
+			std::string upper = text;
+			Utils::String::toUpperInPlace(upper);
+			if(upper != referenceToUpper(text))
+				return mismatch("toUpperInPlace", text, referenceToUpper(text), upper);
+
+			std::string lower = text;
+			Utils::String::toLowerInPlace(lower);
+			if(lower != referenceToLower(text))
+				return mismatch("toLowerInPlace", text, referenceToLower(text), lower);
+
+			std::string trimmed = text;
+			Utils::String::trimInPlace(trimmed);
+			if(trimmed != Utils::String::trim(text))
+				return mismatch("trimInPlace", text, Utils::String::trim(text), trimmed);
+
+			const int expectedOrder = referenceCompareIgnoreCase(text, other);
+			const int order         = Utils::String::compareIgnoreCase(text, other);
+			if(order != expectedOrder)
+				return mismatch("compareIgnoreCase", text + "\" vs \"" + other, std::to_string(expectedOrder), std::to_string(order));
+
+			const bool equal = Utils::String::equalsIgnoreCase(text, other);
+			if(equal != (expectedOrder == 0))
+				return mismatch("equalsIgnoreCase", text + "\" vs \"" + other, std::to_string(expectedOrder == 0), std::to_string(equal));
+
+			std::string path = randomString(rng, pathAlphabet, sizeof(pathAlphabet) - 1);
+			if(rng() % 4 == 0)
+				path = "\\\\?\\" + path;
+
+			if(Utils::FileSystem::getGenericPath(path) != referenceGetGenericPath(path))
+				return mismatch("getGenericPath", path, referenceGetGenericPath(path), Utils::FileSystem::getGenericPath(path));
+		}
+
+		return true;
+
+	} // stringUtilEquivalence
+
+	void stringUtilBenchmark()
+	{
+		std::mt19937                   rng(59);
+		const std::vector<std::string> names = randomNames(rng, 2000);
+		std::vector<std::string>       sorted;
+		std::vector<std::string>       paths;
+		static volatile size_t         sink = 0;
+
+		for(unsigned int i = 0; i < names.size(); ++i)
+			paths.push_back("C:\\Users\\Player\\.emulationstation\\roms\\snes\\\\" + names[i] + ".zip\\");
+
+		benchmark("sort 2000 names, compareIgnoreCase", 50, [&]()
+		{
+			sorted = names;
+			std::sort(sorted.begin(), sorted.end(), [](const std::string& _a, const std::string& _b) { return Utils::String::compareIgnoreCase(_a, _b) < 0; });
+			sink = sink + sorted.front().length();
+		});
+
+		benchmark("sort 2000 names, toUpper copies (reference)", 50, [&]()
+		{
+			sorted = names;
+			std::sort(sorted.begin(), sorted.end(), [](const std::string& _a, const std::string& _b) { return referenceToUpper(_a).compare(referenceToUpper(_b)) < 0; });
+			sink = sink + sorted.front().length();
+		});
+
+		benchmark("copy + toUpperInPlace, 2000 names", 500, [&]()
+		{
+			sorted = names;
+			for(unsigned int i = 0; i < sorted.size(); ++i)
+				Utils::String::toUpperInPlace(sorted[i]);
+			sink = sink + sorted.back().length();
+		});
+
+		benchmark("toUpper, 2000 names (reference)", 500, [&]()
+		{
+			for(unsigned int i = 0; i < names.size(); ++i)
+				sink = sink + referenceToUpper(names[i]).length();
+		});
+
+		benchmark("getGenericPath, 2000 Windows paths", 500, [&]()
+		{
+			for(unsigned int i = 0; i < paths.size(); ++i)
+				sink = sink + Utils::FileSystem::getGenericPath(paths[i]).length();
+		});
+
+		benchmark("getGenericPath, 2000 Windows paths (reference)", 500, [&]()
+		{
+			for(unsigned int i = 0; i < paths.size(); ++i)
+				sink = sink + referenceGetGenericPath(paths[i]).length();
+		});
+
+	} // stringUtilBenchmark
+
+} // Tests::
@@ -0,0 +1,22 @@
+#pragma once
+#ifndef ES_CORE_TESTS_TESTS_H
+#define ES_CORE_TESTS_TESTS_H
+
+#include <functional>
+
+// checks return false on a failure, after printing what went wrong
+// benchmarks print their own timings through benchmark()
+namespace Tests
+{
+	bool transform4x4fSimd();
+	bool stringUtilEquivalence();
+
+	void mathBenchmark();
+	void textLayoutBenchmark();
+	void stringUtilBenchmark();
+
+	void benchmark(const char* _name, const unsigned int _iterations, const std::function<void()>& _run); // prints the average time of one run
+
+} // Tests::
+
+#endif // ES_CORE_TESTS_TESTS_H
@@ -0,0 +1,73 @@
+//es-core-tests
+//Self checks for es-core, built with -DTESTS=ON and run by ctest.
+//Run with --benchmark to time the hot paths instead.
+
+#include "utils/FileSystemUtil.h"
+#include "Tests.h"
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <string.h>
+
+struct Check
+{
+	const char* name;
+	bool (*run)();
+};
+
+static const Check checks[] = {
+	{ "Transform4x4f SIMD matches scalar",             Tests::transform4x4fSimd     },
+	{ "Utils::String and getGenericPath match the old", Tests::stringUtilEquivalence }
+};
+
+static void (* const benchmarks[])() = {
+	Tests::mathBenchmark,
+	Tests::textLayoutBenchmark,
+	Tests::stringUtilBenchmark
+};
+
+namespace Tests
+{
+	void benchmark(const char* _name, const unsigned int _iterations, const std::function<void()>& _run)
+	{
+		// one untimed run to warm up the caches
+		_run();
+
+		const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		for(unsigned int i = 0; i < _iterations; i++)
+			_run();
+		const std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+
+		const double us = std::chrono::duration_cast<std::chrono::duration<double, std::micro>>(end - start).count() / _iterations;
+		std::cout << std::left << std::setw(56) << _name << std::right << std::fixed << std::setprecision(2) << std::setw(12) << us << " us\n";
+
+	} // benchmark
+
+} // Tests::
+
+int main(int argc, char* argv[])
+{
+	// fonts and other resources are looked up next to the executable
+	Utils::FileSystem::setExePath(argv[0]);
+
+	if(argc > 1 && strcmp(argv[1], "--benchmark") == 0)
+	{
+		for(unsigned int i = 0; i < sizeof(benchmarks) / sizeof(benchmarks[0]); i++)
+			benchmarks[i]();
+
+		return 0;
+	}
+
+	int failed = 0;
+
+	for(unsigned int i = 0; i < sizeof(checks) / sizeof(checks[0]); i++)
+	{
+		const bool ok = checks[i].run();
+		std::cout << (ok ? "[ ok ] " : "[FAIL] ") << checks[i].name << "\n";
+
+		if(!ok)
+			failed++;
+	}
+
+	return failed ? 1 : 0;
+}